@@ -0,0 +1,492 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Benchmark das operacoes de ECDSA_ECDH_C25519.CPP (programa separado).
+Compilar: g++ -O2 -pthread -o ECC_benchmark ECC_benchmark.cpp -lgmp
+Uso: ./ECC_benchmark [max_threads]
+____________________________________________________________________________*/
+
+#define ECC_SEM_MAIN
+#include "ECDSA_ECDH_C25519.CPP"
+
+#include <chrono>
+#include <cstdio>
+
+// Tempo de parede em nanossegundos
+static double agora_ns()
+{
+    return chrono::duration<double, nano>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Custo por operacao do lote (uma inversao para N lacos) contra N chamadas individuais
+void bench_lote()
+{
+    const size_t MAX_LOTE = 1024;
+    const size_t OPS_POR_TAMANHO = 4096;
+
+    mpz_t *ks = new mpz_t[MAX_LOTE], *us = new mpz_t[MAX_LOTE], *rs = new mpz_t[MAX_LOTE];
+    gmp_randstate_t estado;
+    gmp_randinit_default(estado);
+    gmp_randseed_ui(estado, 25519);
+    for (size_t i = 0; i < MAX_LOTE; ++i)
+    {
+        mpz_inits(ks[i], us[i], NULL);
+        mpz_init2(rs[i], 256);
+        mpz_urandomb(ks[i], estado, 255);
+        mpz_urandomm(us[i], estado, p);
+    }
+
+    printf("\n__________________Multiplicacao escalar em lote__________________\n");
+    printf("%8s %16s %16s %10s\n", "lote", "individual ns/op", "lote ns/op", "ganho");
+
+    for (size_t lote = 1; lote <= MAX_LOTE; lote *= 2)
+    {
+        size_t rodadas = OPS_POR_TAMANHO / lote;
+        if (rodadas == 0)
+            rodadas = 1;
+
+        // aquecimento (tambem dimensiona a area de trabalho do lote)
+        multiplicacao_escalar_lote(rs, ks, us, lote);
+
+        double t0 = agora_ns();
+        for (size_t r = 0; r < rodadas; ++r)
+            for (size_t i = 0; i < lote; ++i)
+                multiplicacao_escalar(rs[i], ks[i], us[i]);
+        double t_ind = (agora_ns() - t0) / (rodadas * lote);
+
+        t0 = agora_ns();
+        for (size_t r = 0; r < rodadas; ++r)
+            multiplicacao_escalar_lote(rs, ks, us, lote);
+        double t_lote = (agora_ns() - t0) / (rodadas * lote);
+
+        printf("%8zu %16.0f %16.0f %9.2fx\n", lote, t_ind, t_lote, t_ind / t_lote);
+    }
+
+    for (size_t i = 0; i < MAX_LOTE; ++i)
+        mpz_clears(ks[i], us[i], rs[i], NULL);
+    delete[] ks;
+    delete[] us;
+    delete[] rs;
+    gmp_randclear(estado);
+}
+
+// Base fixa (tabela + Edwards) contra a escada de Montgomery para k*P_0.x
+void bench_base_fixa()
+{
+    const size_t OPS = 4096;
+    mpz_t k, r;
+    mpz_init(k);
+    mpz_init2(r, 256);
+    gmp_randstate_t estado;
+    gmp_randinit_default(estado);
+    gmp_randseed_ui(estado, 9);
+    mpz_urandomb(k, estado, 255);
+
+    multiplicacao_escalar_base(r, k); // aquecimento (monta a tabela)
+
+    double t0 = agora_ns();
+    for (size_t i = 0; i < OPS; ++i)
+        multiplicacao_escalar(r, k, P_0.x);
+    double t_escada = (agora_ns() - t0) / OPS;
+
+    t0 = agora_ns();
+    for (size_t i = 0; i < OPS; ++i)
+        multiplicacao_escalar_base(r, k);
+    double t_base = (agora_ns() - t0) / OPS;
+
+    printf("\n__________________Multiplicacao pela base fixa (u = 9)__________________\n");
+    printf("%-24s %12.0f ns/op\n", "escada de Montgomery", t_escada);
+    printf("%-24s %12.0f ns/op (%.2fx)\n", "tabela pre-computada", t_base, t_escada / t_base);
+
+    gmp_randclear(estado);
+    mpz_clears(k, r, NULL);
+}
+
+// Escada escalar contra a escada AVX2 4-way para muitas multiplicacoes independentes
+void bench_avx2()
+{
+    const size_t OPS = 4096;
+    mpz_t *ks = new mpz_t[OPS], *us = new mpz_t[OPS], *rs = new mpz_t[OPS];
+    gmp_randstate_t estado;
+    gmp_randinit_default(estado);
+    gmp_randseed_ui(estado, 4);
+    for (size_t i = 0; i < OPS; ++i)
+    {
+        mpz_inits(ks[i], us[i], NULL);
+        mpz_init2(rs[i], 256);
+        mpz_urandomb(ks[i], estado, 255);
+        mpz_urandomm(us[i], estado, p);
+    }
+
+    printf("\n__________________Escada de Montgomery: escalar x AVX2 4-way__________________\n");
+
+    double t0 = agora_ns();
+    multiplicacao_escalar_multipla(rs, ks, us, OPS, false);
+    double t_escalar = (agora_ns() - t0) / OPS;
+    printf("%-24s %12.0f ns/op\n", "escalar em lote (2^51)", t_escalar);
+
+    if (usa_avx2())
+    {
+        t0 = agora_ns();
+        multiplicacao_escalar_multipla(rs, ks, us, OPS, true);
+        double t_avx2 = (agora_ns() - t0) / OPS;
+        printf("%-24s %12.0f ns/op (%.2fx)\n", "AVX2 4-way (radix 2^25.5)", t_avx2, t_escalar / t_avx2);
+    }
+    else
+        printf("CPU sem AVX2\n");
+
+    for (size_t i = 0; i < OPS; ++i)
+        mpz_clears(ks[i], us[i], rs[i], NULL);
+    delete[] ks;
+    delete[] us;
+    delete[] rs;
+    gmp_randclear(estado);
+}
+
+// Gerador de carga do ServicoChaves: ops/s de geracao de chaves e de acordo ECDH com 1..N threads
+void bench_servico(unsigned max_threads)
+{
+    const size_t OPS = 2048;
+
+    mpz_t *prv = new mpz_t[OPS], *pbl = new mpz_t[OPS], *seg = new mpz_t[OPS];
+    for (size_t i = 0; i < OPS; ++i)
+    {
+        mpz_inits(prv[i], pbl[i], NULL);
+        mpz_init2(seg[i], 256);
+    }
+
+    printf("\n__________________Servico multi-thread (work stealing)__________________\n");
+    printf("%8s %16s %16s %12s\n", "threads", "keygen ops/s", "ECDH ops/s", "escala ECDH");
+
+    double ecdh_1 = 0;
+    for (unsigned t = 1;; t = min(2 * t, max_threads)) // 1, 2, 4, ..., max_threads
+    {
+        ServicoChaves servico(t);
+
+        double t0 = agora_ns();
+        for (size_t i = 0; i < OPS; ++i)
+            servico.submete_geracao_chave(prv[i], pbl[i]);
+        servico.aguarda();
+        double keygen = OPS / ((agora_ns() - t0) * 1e-9);
+
+        t0 = agora_ns();
+        for (size_t i = 0; i < OPS; ++i)
+            servico.submete_segredo_compartilhado(seg[i], prv[i], pbl[(i + 1) % OPS]);
+        servico.aguarda();
+        double ecdh = OPS / ((agora_ns() - t0) * 1e-9);
+        if (t == 1)
+            ecdh_1 = ecdh;
+
+        printf("%8u %16.0f %16.0f %11.2fx\n", t, keygen, ecdh, ecdh / ecdh_1);
+        if (t == max_threads)
+            break;
+    }
+
+    for (size_t i = 0; i < OPS; ++i)
+        mpz_clears(prv[i], pbl[i], seg[i], NULL);
+    delete[] prv;
+    delete[] pbl;
+    delete[] seg;
+}
+
+// Codificacao mensagem -> ponto: tentativas x = msg*100 + j contra Elligator 2 (media e pior caso)
+void bench_codificacao()
+{
+    const size_t OPS = 4096;
+    mpz_t msg;
+    mpz_init(msg);
+    gmp_randstate_t estado;
+    gmp_randinit_default(estado);
+    gmp_randseed_ui(estado, 2);
+
+    double soma[2] = {0, 0}, pior[2] = {0, 0};
+    for (size_t i = 0; i < OPS; ++i)
+    {
+        mpz_urandomb(msg, estado, 240);
+
+        Ponto Q;
+        initPonto(Q);
+        double t0 = agora_ns();
+        Ponto P = codifica_mensagem_para_ponto_da_c25519(msg);
+        double t1 = agora_ns();
+        codifica_mensagem_elligator2(Q, msg); // msg de 240 bits: sempre aceita
+        double t2 = agora_ns();
+
+        soma[0] += t1 - t0;
+        soma[1] += t2 - t1;
+        pior[0] = max(pior[0], t1 - t0);
+        pior[1] = max(pior[1], t2 - t1);
+        clearPonto(P);
+        clearPonto(Q);
+    }
+
+    printf("\n__________________Codificacao mensagem -> ponto__________________\n");
+    printf("%-24s %12s %12s\n", "", "media ns", "pior ns");
+    printf("%-24s %12.0f %12.0f\n", "x = msg*100 + j", soma[0] / OPS, pior[0]);
+    printf("%-24s %12.0f %12.0f\n", "Elligator 2", soma[1] / OPS, pior[1]);
+
+    gmp_randclear(estado);
+    mpz_clear(msg);
+}
+
+// Criptografia em fluxo: ChaCha20 em memoria e encriptar_fluxo de arquivo para /dev/null (MB/s)
+void bench_fluxo()
+{
+    const size_t TAM = 64 << 20; // 64 MiB
+
+    vector<uint8_t> buf(TAM_PEDACO_FLUXO, 0xA5);
+    uint8_t chave[32] = {1}, nonce[12] = {0};
+    ChaCha20 cifra;
+    chacha20_inicia(cifra, chave, nonce, 0);
+    double t0 = agora_ns();
+    for (size_t feitos = 0; feitos < TAM; feitos += buf.size())
+        chacha20_xor(cifra, buf.data(), buf.data(), buf.size());
+    double mb_s_cifra = (TAM / 1e6) / ((agora_ns() - t0) * 1e-9);
+
+    mpz_t prv, pbl;
+    mpz_inits(prv, pbl, NULL);
+    gera_escalar_rand(prv);
+    multiplicacao_escalar_base(pbl, prv);
+
+    FILE *entrada = tmpfile(), *nulo = fopen("/dev/null", "wb");
+    for (size_t feitos = 0; feitos < TAM; feitos += buf.size())
+        fwrite(buf.data(), 1, buf.size(), entrada);
+    rewind(entrada);
+
+    t0 = agora_ns();
+    encriptar_fluxo(entrada, nulo, pbl);
+    double mb_s_fluxo = (TAM / 1e6) / ((agora_ns() - t0) * 1e-9);
+
+    printf("\n__________________Criptografia em fluxo (64 MiB)__________________\n");
+    printf("%-24s %12.0f MB/s\n", "ChaCha20 em memoria", mb_s_cifra);
+    printf("%-24s %12.0f MB/s\n", "encriptar_fluxo", mb_s_fluxo);
+
+    fclose(entrada);
+    fclose(nulo);
+    mpz_clears(prv, pbl, NULL);
+}
+
+// SHA-512 (MB/s por tamanho de mensagem) e custo de uma derivacao HKDF de 32 bytes
+void bench_sha512()
+{
+    const size_t TOTAL = 64 << 20; // bytes processados por tamanho
+    const size_t tamanhos[] = {64, 1024, 16384, 1 << 20};
+    vector<uint8_t> buf(1 << 20, 0x5A);
+    uint8_t hash[SHA512_TAM_HASH];
+
+    printf("\n__________________SHA-512__________________\n");
+    printf("%10s %12s\n", "mensagem", "MB/s");
+    for (size_t tam : tamanhos)
+    {
+        double t0 = agora_ns();
+        for (size_t feitos = 0; feitos < TOTAL; feitos += tam)
+            sha512(hash, buf.data(), tam);
+        printf("%10zu %12.0f\n", tam, (TOTAL / 1e6) / ((agora_ns() - t0) * 1e-9));
+    }
+
+    const size_t OPS = 100000;
+    uint8_t prk[SHA512_TAM_HASH], chave[32];
+    double t0 = agora_ns();
+    for (size_t i = 0; i < OPS; ++i)
+    {
+        hkdf_extract(prk, hash, 32, buf.data(), 32);
+        hkdf_expand(chave, sizeof(chave), prk, (const uint8_t *)"bench", 5);
+        hash[0] ^= chave[0];
+    }
+    printf("%-24s %12.0f ns/op\n", "HKDF (extract + 32 B)", (agora_ns() - t0) / OPS);
+}
+
+// Ed25519: assinaturas verificadas por segundo, individual contra lotes de 8 a 1024
+void bench_ed25519()
+{
+    const size_t MAX_LOTE = 1024;
+    vector<uint8_t> sks(32 * MAX_LOTE), pks(32 * MAX_LOTE), assinaturas(64 * MAX_LOTE), msgs(64 * MAX_LOTE);
+    vector<const uint8_t *> m(MAX_LOTE), a(MAX_LOTE), k(MAX_LOTE);
+    vector<size_t> tams(MAX_LOTE, 64);
+    for (size_t i = 0; i < MAX_LOTE; ++i)
+    {
+        for (size_t j = 0; j < 32; ++j)
+            sks[32 * i + j] = (uint8_t)(i * 7 + j * 13);
+        for (size_t j = 0; j < 64; ++j)
+            msgs[64 * i + j] = (uint8_t)(i + j);
+        ed25519_chave_publica(&pks[32 * i], &sks[32 * i]);
+        m[i] = &msgs[64 * i];
+        k[i] = &pks[32 * i];
+        a[i] = &assinaturas[64 * i];
+    }
+
+    double t0 = agora_ns();
+    for (size_t i = 0; i < MAX_LOTE; ++i)
+        ed25519_assina(&assinaturas[64 * i], m[i], 64, &sks[32 * i], k[i]);
+    double assina_s = MAX_LOTE / ((agora_ns() - t0) * 1e-9);
+
+    t0 = agora_ns();
+    for (size_t i = 0; i < MAX_LOTE; ++i)
+        ed25519_verifica(a[i], m[i], 64, k[i]);
+    double individual_s = MAX_LOTE / ((agora_ns() - t0) * 1e-9);
+
+    printf("\n__________________Ed25519__________________\n");
+    printf("%-24s %12.0f assinaturas/s\n", "assinatura", assina_s);
+    printf("%8s %16s %10s\n", "lote", "verificacoes/s", "ganho");
+    printf("%8s %16.0f %9.2fx\n", "1", individual_s, 1.0);
+
+    for (size_t lote = 8; lote <= MAX_LOTE; lote *= 2)
+    {
+        t0 = agora_ns();
+        for (size_t ini = 0; ini < MAX_LOTE; ini += lote)
+            ed25519_verifica_lote(&m[ini], &tams[ini], &a[ini], &k[ini], lote);
+        double lote_s = MAX_LOTE / ((agora_ns() - t0) * 1e-9);
+        printf("%8zu %16.0f %9.2fx\n", lote, lote_s, lote_s / individual_s);
+    }
+}
+
+// Acordo ECDH com pares recorrentes: escada sempre contra cache de segredos (acerto)
+void bench_cache_segredos()
+{
+    const size_t PARES = 16, OPS = 20000;
+
+    mpz_t prv, seg, pbl[PARES];
+    mpz_init(prv);
+    mpz_init2(seg, 256);
+    for (size_t i = 0; i < PARES; ++i)
+    {
+        mpz_init(pbl[i]);
+        gera_escalar_rand(seg);
+        multiplicacao_escalar_base(pbl[i], seg);
+    }
+    gera_escalar_rand(prv);
+
+    printf("\n__________________Cache de segredos (%zu pares recorrentes)__________________\n", PARES);
+
+    double t0 = agora_ns();
+    for (size_t i = 0; i < OPS / 10; ++i)
+        multiplicacao_escalar(seg, prv, pbl[i % PARES]);
+    double escada = (agora_ns() - t0) / (OPS / 10);
+
+    CacheSegredos cache(PARES);
+    const uint64_t id = cache.registra_chave_local(prv);
+    t0 = agora_ns();
+    for (size_t i = 0; i < OPS; ++i)
+        cache.segredo_compartilhado(seg, id, pbl[i % PARES]);
+    double com_cache = (agora_ns() - t0) / OPS;
+    EstatisticasCache e = cache.estatisticas();
+
+    printf("%-28s %12.0f ns/op\n", "escada (sem cache)", escada);
+    printf("%-28s %12.0f ns/op %10.1fx\n", "cache", com_cache, escada / com_cache);
+    printf("acertos %llu, falhas %llu, remocoes %llu\n", (unsigned long long)e.acertos,
+           (unsigned long long)e.falhas, (unsigned long long)e.remocoes);
+
+    for (size_t i = 0; i < PARES; ++i)
+        mpz_clear(pbl[i]);
+    mpz_clears(prv, seg, NULL);
+}
+
+// Conversao antiga (referencia): 256^i e uma soma por caractere na ida, divisoes por 256 na volta
+static void string_to_mpz_quadratico(const string &s, mpz_t x)
+{
+    mpz_t t;
+    mpz_init(t);
+    mpz_set_ui(x, 0);
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        mpz_ui_pow_ui(t, 256, i);
+        mpz_mul_ui(t, t, (unsigned char)s[i]);
+        mpz_add(x, x, t);
+    }
+    mpz_clear(t);
+}
+
+static string mpz_to_string_quadratico(const mpz_t x)
+{
+    mpz_t v, r;
+    mpz_inits(v, r, NULL);
+    mpz_set(v, x);
+    string s;
+    while (mpz_sgn(v) > 0)
+    {
+        mpz_tdiv_r_ui(r, v, 256);
+        s.push_back((char)mpz_get_ui(r));
+        mpz_tdiv_q_ui(v, v, 256);
+    }
+    mpz_clears(v, r, NULL);
+    return s;
+}
+
+// Codec de bytes de 16 B a 1 MB: ida e volta string <-> mpz_t, antigo (O(n²), ate 4 KB) contra linear
+void bench_codec_bytes()
+{
+    const size_t MAX_TAM = 1 << 20, MAX_TAM_ANTIGO = 4096;
+
+    string s(MAX_TAM, '\0');
+    for (size_t i = 0; i < MAX_TAM; ++i)
+        s[i] = (char)('a' + i % 26);
+    mpz_t x;
+    mpz_init2(x, 8 * MAX_TAM + 64); // capacidade para o maior tamanho: medicao sem realocar o destino
+
+    printf("\n__________________Codec de bytes (ida e volta string <-> mpz_t)__________________\n");
+    printf("%10s %16s %16s %12s %12s\n", "bytes", "antigo us/op", "linear us/op", "linear MB/s", "alocs/op");
+
+    for (size_t tam = 16; tam <= MAX_TAM; tam *= 4)
+    {
+        const string msg = s.substr(0, tam);
+        const size_t ops = max((size_t)4, (size_t)(1 << 22) / tam);
+
+        double antigo = -1;
+        if (tam <= MAX_TAM_ANTIGO)
+        {
+            size_t ops_antigo = max((size_t)2, ops / 16);
+            double t0 = agora_ns();
+            for (size_t i = 0; i < ops_antigo; ++i)
+            {
+                string_to_mpz_quadratico(msg, x);
+                if (mpz_to_string_quadratico(x).size() != tam)
+                    printf("erro no antigo\n");
+            }
+            antigo = (agora_ns() - t0) / ops_antigo * 1e-3;
+        }
+
+        unsigned long alocs = alocacoes_gmp();
+        double t0 = agora_ns();
+        for (size_t i = 0; i < ops; ++i)
+        {
+            string_to_mpz(msg, x);
+            if (mpz_para_string(x).size() != tam)
+                printf("erro no linear\n");
+        }
+        double linear = (agora_ns() - t0) / ops * 1e-3;
+        double alocs_op = (double)(alocacoes_gmp() - alocs) / ops;
+
+        if (antigo >= 0)
+            printf("%10zu %16.2f %16.2f %12.1f %12.2f\n", tam, antigo, linear, tam / linear, alocs_op);
+        else
+            printf("%10zu %16s %16.2f %12.1f %12.2f\n", tam, "-", linear, tam / linear, alocs_op);
+    }
+    mpz_clear(x);
+}
+
+int main(int argc, char *argv[])
+{
+    inic_contador_alocacoes(); // alocs/op do codec de bytes
+    inic_parametros_c25519();
+
+    unsigned max_threads = thread::hardware_concurrency();
+    if (argc > 1)
+        max_threads = (unsigned)atoi(argv[1]);
+    if (max_threads == 0)
+        max_threads = 1;
+
+    bench_lote();
+    bench_base_fixa();
+    bench_avx2();
+    bench_servico(max_threads);
+    bench_cache_segredos();
+    bench_codificacao();
+    bench_codec_bytes();
+    bench_fluxo();
+    bench_sha512();
+    bench_ed25519();
+
+    return 0;
+}
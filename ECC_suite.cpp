@@ -0,0 +1,670 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Suite unificada de benchmark: as mesmas operacoes (multiplicacao escalar,
+geracao de chaves, codificacao/decodificacao e encriptacao/decriptacao) em
+cada backend, com ciclos/op, percentis de ns/op, alocacoes/op e ops/s.
+    gmp       escada de Montgomery em mpz_t (mpz_mul + mpz_mod a cada passo),
+              reescrita da escada original para medir so a aritmetica da GMP
+    ntl       coordenadas afins em NTL::ZZ com InvMod em cada soma/duplicacao,
+              a abordagem de ECC_comparacao.cpp (que fixa k = 11 e imprime cada
+              passo, entao nao roda como backend) com a curva de Montgomery
+              corrigida; so com -DCOM_NTL. Sem o NTL instalado o backend nao eh
+              compilado e o JSON traz "ntl": null
+    otimizado fe25519 (radix 2^51), tabela da base fixa e fe_sqrt
+
+Compilar: g++ -O2 -pthread -o ECC_suite ECC_suite.cpp -lgmp
+    com NTL: g++ -O2 -pthread -DCOM_NTL -o ECC_suite ECC_suite.cpp -lntl -lgmp
+    com contadores por estagio: acrescentar -DECC_INSTRUMENTACAO
+Uso: ./ECC_suite [--ops N] [--json arquivo.json]
+O JSON tem um objeto por (backend, operacao) para acompanhar regressoes entre versoes.
+____________________________________________________________________________*/
+
+#define ECC_SEM_MAIN
+#include "ECDSA_ECDH_C25519.CPP"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc
+#define SUITE_TEM_RDTSC 1
+#else
+#define SUITE_TEM_RDTSC 0
+#endif
+#ifdef COM_NTL
+#include <NTL/ZZ.h>
+#define SUITE_TEM_NTL 1
+#else
+#define SUITE_TEM_NTL 0
+#endif
+
+static double agora_ns()
+{
+    return chrono::duration<double, nano>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// lfence antes e depois: o rdtsc nao sai do lugar em relacao a operacao medida
+static uint64_t ciclos()
+{
+#if SUITE_TEM_RDTSC
+    _mm_lfence();
+    uint64_t c = __rdtsc();
+    _mm_lfence();
+    return c;
+#else
+    return 0;
+#endif
+}
+
+// Custo da propria medicao (janela de mede() sem operacao dentro, mediana), descontado de cada chamada
+struct CustoMedicao
+{
+    double ns;
+    uint64_t ciclos;
+};
+
+static CustoMedicao custo_medicao()
+{
+    static const CustoMedicao custo = []() {
+        vector<double> ns(1001);
+        vector<uint64_t> cs(1001);
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            double t0 = agora_ns();
+            uint64_t c0 = ciclos();
+            cs[i] = ciclos() - c0;
+            ns[i] = agora_ns() - t0;
+        }
+        sort(ns.begin(), ns.end());
+        sort(cs.begin(), cs.end());
+        return CustoMedicao{ns[ns.size() / 2], cs[cs.size() / 2]};
+    }();
+    return custo;
+}
+
+// ________________________Medicao________________________
+
+struct Medida
+{
+    string backend, operacao;
+    size_t ops;
+    double ciclos_op, ns_medio, ns_p50, ns_p90, ns_p99, ops_s;
+    double alocs_op; // alocacoes da GMP por operacao (< 0: nao medido)
+};
+
+vector<Medida> medidas;
+
+// Executa op(i) para i = 0..ops-1, medindo cada chamada. Os ciclos sao lidos so em volta
+// de op(i) (sem o relogio nem o laco); ns e ciclos descontam o custo da janela vazia
+void mede(const char *backend, const char *operacao, size_t ops, bool conta_alocs, const function<void(size_t)> &op)
+{
+    vector<double> ns(ops);
+    const CustoMedicao custo = custo_medicao();
+    op(0); // aquecimento (tabelas, contextos por thread)
+
+    unsigned long alocs_antes = alocacoes_gmp();
+    uint64_t soma_ciclos = 0;
+    for (size_t i = 0; i < ops; ++i)
+    {
+        double t0 = agora_ns();
+        uint64_t c0 = ciclos();
+        op(i);
+        uint64_t c = ciclos() - c0;
+        ns[i] = max(agora_ns() - t0 - custo.ns, 0.0);
+        soma_ciclos += c > custo.ciclos ? c - custo.ciclos : 0;
+    }
+    unsigned long alocs = alocacoes_gmp() - alocs_antes;
+
+    double soma = 0;
+    for (double v : ns)
+        soma += v;
+    sort(ns.begin(), ns.end());
+
+    Medida m;
+    m.backend = backend;
+    m.operacao = operacao;
+    m.ops = ops;
+    m.ciclos_op = SUITE_TEM_RDTSC ? (double)soma_ciclos / ops : -1;
+    m.ns_medio = soma / ops;
+    m.ns_p50 = ns[ops / 2];
+    m.ns_p90 = ns[(ops * 90) / 100];
+    m.ns_p99 = ns[(ops * 99) / 100];
+    m.ops_s = 1e9 / m.ns_medio;
+    m.alocs_op = conta_alocs ? (double)alocs / ops : -1;
+    medidas.push_back(m);
+
+    printf("%-10s %-12s %8zu %12.0f %10.0f %10.0f %10.0f %10.1f %12.0f\n", backend, operacao, ops, m.ciclos_op,
+           m.ns_p50, m.ns_p90, m.ns_p99, m.alocs_op, m.ops_s);
+}
+
+void escreve_json(const char *arquivo, size_t ops)
+{
+    FILE *f = fopen(arquivo, "w");
+    if (!f)
+    {
+        cerr << "Erro ao abrir " << arquivo << endl;
+        return;
+    }
+    fprintf(f, "{\n  \"suite\": \"ECC_suite\",\n  \"timestamp\": %ld,\n  \"compilador\": \"%s\",\n", (long)time(NULL), __VERSION__);
+    fprintf(f, "  \"ops_por_medida\": %zu,\n  \"avx2\": %s,\n", ops, usa_avx2() ? "true" : "false");
+    // Backends compilados; null = nao compilado (o esquema nao muda com as flags)
+    fprintf(f, "  \"backends\": {\"gmp\": true, \"ntl\": %s, \"otimizado\": true},\n  \"resultados\": [\n",
+            SUITE_TEM_NTL ? "true" : "null");
+    for (size_t i = 0; i < medidas.size(); ++i)
+    {
+        const Medida &m = medidas[i];
+        fprintf(f, "    {\"backend\": \"%s\", \"operacao\": \"%s\", \"ops\": %zu, ", m.backend.c_str(), m.operacao.c_str(), m.ops);
+        if (m.ciclos_op >= 0)
+            fprintf(f, "\"ciclos_op\": %.1f, ", m.ciclos_op);
+        else
+            fprintf(f, "\"ciclos_op\": null, ");
+        fprintf(f, "\"ns_medio\": %.1f, \"ns_p50\": %.1f, \"ns_p90\": %.1f, \"ns_p99\": %.1f, ", m.ns_medio, m.ns_p50, m.ns_p90, m.ns_p99);
+        if (m.alocs_op >= 0)
+            fprintf(f, "\"alocs_op\": %.2f, ", m.alocs_op);
+        else
+            fprintf(f, "\"alocs_op\": null, ");
+        fprintf(f, "\"ops_s\": %.1f}%s\n", m.ops_s, i + 1 < medidas.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+// ________________________Entradas comuns________________________
+
+// Mesmas entradas para todos os backends (semente fixa)
+struct Entradas
+{
+    size_t ops;
+    mpz_t *ks;   // escalares de 255 bits (multiplicacao escalar e chaves efemeras)
+    mpz_t *msgs; // mensagens de 200 bits
+    mpz_t prv, pbl; // par de chaves do destinatario
+};
+
+void inic_entradas(Entradas &e, size_t ops)
+{
+    e.ops = ops;
+    e.ks = new mpz_t[ops];
+    e.msgs = new mpz_t[ops];
+    gmp_randstate_t estado;
+    gmp_randinit_default(estado);
+    gmp_randseed_ui(estado, 25519);
+    for (size_t i = 0; i < ops; ++i)
+    {
+        mpz_inits(e.ks[i], e.msgs[i], NULL);
+        mpz_urandomb(e.ks[i], estado, 255);
+        mpz_urandomb(e.msgs[i], estado, 200);
+    }
+    mpz_inits(e.prv, e.pbl, NULL);
+    mpz_urandomb(e.prv, estado, 255);
+    multiplicacao_escalar_base(e.pbl, e.prv);
+    gmp_randclear(estado);
+}
+
+void limpa_entradas(Entradas &e)
+{
+    for (size_t i = 0; i < e.ops; ++i)
+        mpz_clears(e.ks[i], e.msgs[i], NULL);
+    delete[] e.ks;
+    delete[] e.msgs;
+    mpz_clears(e.prv, e.pbl, NULL);
+}
+
+// Saidas reaproveitadas entre operacoes (ex.: encripta -> decripta)
+struct Saidas
+{
+    size_t ops;
+    mpz_t *x, *C1, *C2;
+};
+
+void inic_saidas(Saidas &s, size_t ops)
+{
+    s.ops = ops;
+    s.x = new mpz_t[ops];
+    s.C1 = new mpz_t[ops];
+    s.C2 = new mpz_t[ops];
+    for (size_t i = 0; i < ops; ++i)
+    {
+        mpz_init2(s.x[i], 256);
+        mpz_init2(s.C1[i], 256);
+        mpz_init2(s.C2[i], 256);
+    }
+}
+
+void limpa_saidas(Saidas &s)
+{
+    for (size_t i = 0; i < s.ops; ++i)
+        mpz_clears(s.x[i], s.C1[i], s.C2[i], NULL);
+    delete[] s.x;
+    delete[] s.C1;
+    delete[] s.C2;
+}
+
+// C2 = x XOR HKDF(C1, segredo): mesmo esquema de encriptar_mensagem para todos os backends
+void xor_chave(mpz_t &saida, const mpz_t entrada, mpz_t &C1, mpz_t &segredo)
+{
+    uint8_t chave[32];
+    mpz_t k;
+    mpz_init2(k, 256);
+    deriva_chave_simetrica(chave, sizeof(chave), C1, segredo, "C25519 mensagem");
+    mpz_import(k, sizeof(chave), -1, 1, 0, 0, chave);
+    mpz_xor(saida, entrada, k);
+    mpz_clear(k);
+}
+
+// Caminho de decodifica_ponto_para_string sem a impressao: msg = x/100 e os seus bytes
+void decodifica_para_string(string &msg, mpz_t &tmp, const mpz_t x)
+{
+    mpz_tdiv_q_ui(tmp, x, 100);
+    msg = mpz_para_string(tmp);
+}
+
+// ________________________Backend gmp: escada de Montgomery em mpz_t________________________
+
+struct LadderGmp
+{
+    mpz_t x1, x2, z2, x3, z3, A, AA, B, BB, E, C, D, DA, CB, t;
+};
+
+LadderGmp &ladder_gmp()
+{
+    static LadderGmp *l = []() {
+        LadderGmp *n = new LadderGmp;
+        mpz_inits(n->x1, n->x2, n->z2, n->x3, n->z3, n->A, n->AA, n->B, n->BB, n->E, n->C, n->D, n->DA, n->CB, n->t, NULL);
+        return n;
+    }();
+    return *l;
+}
+
+// RFC 7748 com reducao mod p depois de cada produto e inversao por mpz_powm
+void gmp_multiplicacao_escalar(mpz_t &r, const mpz_t k, const mpz_t u)
+{
+    LadderGmp &l = ladder_gmp();
+    mpz_mod(l.x1, u, p);
+    mpz_set_ui(l.x2, 1);
+    mpz_set_ui(l.z2, 0);
+    mpz_set(l.x3, l.x1);
+    mpz_set_ui(l.z3, 1);
+
+    int troca = 0;
+    for (long t = (long)max((size_t)255, mpz_sizeinbase(k, 2)) - 1; t >= 0; --t)
+    {
+        int bit = mpz_tstbit(k, t);
+        troca ^= bit;
+        if (troca)
+        {
+            mpz_swap(l.x2, l.x3);
+            mpz_swap(l.z2, l.z3);
+        }
+        troca = bit;
+
+        mpz_add(l.A, l.x2, l.z2);
+        mpz_mul(l.AA, l.A, l.A);
+        mpz_mod(l.AA, l.AA, p);
+        mpz_sub(l.B, l.x2, l.z2);
+        mpz_mul(l.BB, l.B, l.B);
+        mpz_mod(l.BB, l.BB, p);
+        mpz_sub(l.E, l.AA, l.BB);
+        mpz_add(l.C, l.x3, l.z3);
+        mpz_sub(l.D, l.x3, l.z3);
+        mpz_mul(l.DA, l.D, l.A);
+        mpz_mod(l.DA, l.DA, p);
+        mpz_mul(l.CB, l.C, l.B);
+        mpz_mod(l.CB, l.CB, p);
+
+        mpz_add(l.t, l.DA, l.CB);
+        mpz_mul(l.x3, l.t, l.t);
+        mpz_mod(l.x3, l.x3, p);
+        mpz_sub(l.t, l.DA, l.CB);
+        mpz_mul(l.t, l.t, l.t);
+        mpz_mul(l.z3, l.t, l.x1);
+        mpz_mod(l.z3, l.z3, p);
+        mpz_mul(l.x2, l.AA, l.BB);
+        mpz_mod(l.x2, l.x2, p);
+        mpz_mul(l.t, l.E, a24);
+        mpz_add(l.t, l.t, l.BB);
+        mpz_mul(l.z2, l.E, l.t);
+        mpz_mod(l.z2, l.z2, p);
+    }
+    if (troca)
+    {
+        mpz_swap(l.x2, l.x3);
+        mpz_swap(l.z2, l.z3);
+    }
+
+    mpz_sub_ui(l.t, p, 2);
+    mpz_powm(l.t, l.z2, l.t, p); // z^(p-2) (z = 0 da 0)
+    mpz_mul(r, l.x2, l.t);
+    mpz_mod(r, r, p);
+}
+
+// Codificacao original: Teste de Euler (mpz_powm) e depois raiz por Tonelli-Shanks
+void gmp_codifica(mpz_t &x, const mpz_t msg)
+{
+    mpz_t y2, y, e;
+    mpz_inits(y2, y, e, NULL);
+    mpz_mul_ui(x, msg, 100);
+    mpz_sub_ui(e, p, 1);
+    mpz_tdiv_q_2exp(e, e, 1);
+    while (true)
+    {
+        mpz_add(y2, x, a);
+        mpz_mul(y2, y2, x);
+        mpz_add_ui(y2, y2, 1);
+        mpz_mul(y2, y2, x);
+        mpz_mod(y2, y2, p);
+        mpz_powm(y, y2, e, p);
+        if (mpz_cmp_ui(y, 1) == 0)
+            break;
+        mpz_add_ui(x, x, 1);
+    }
+    raiz_quadrada_modular(y, y2, p);
+    mpz_clears(y2, y, e, NULL);
+}
+
+void bench_gmp(const Entradas &e, Saidas &s)
+{
+    const size_t ops = e.ops;
+    mpz_t k, pub, segredo;
+    mpz_inits(k, pub, segredo, NULL);
+    string msg;
+
+    mede("gmp", "escalar", ops, true, [&](size_t i) { gmp_multiplicacao_escalar(s.x[i], e.ks[i], P_0.x); });
+    mede("gmp", "keygen", ops, true, [&](size_t) {
+        gera_escalar_rand(k);
+        gmp_multiplicacao_escalar(pub, k, P_0.x);
+    });
+    mede("gmp", "codifica", ops, true, [&](size_t i) { gmp_codifica(s.x[i], e.msgs[i]); });
+    mede("gmp", "decodifica", ops, true, [&](size_t i) { decodifica_para_string(msg, k, s.x[i]); });
+    mede("gmp", "encripta", ops, true, [&](size_t i) {
+        gmp_multiplicacao_escalar(s.C1[i], e.ks[i], P_0.x);
+        gmp_multiplicacao_escalar(segredo, e.ks[i], e.pbl);
+        xor_chave(s.C2[i], s.x[i], s.C1[i], segredo);
+    });
+    mede("gmp", "decripta", ops, true, [&](size_t i) {
+        gmp_multiplicacao_escalar(segredo, e.prv, s.C1[i]);
+        xor_chave(k, s.C2[i], s.C1[i], segredo);
+    });
+
+    mpz_clears(k, pub, segredo, NULL);
+}
+
+// ________________________Backend otimizado________________________
+
+void bench_otimizado(const Entradas &e, Saidas &s)
+{
+    const size_t ops = e.ops;
+    mpz_t k, pub, segredo;
+    mpz_inits(k, pub, segredo, NULL);
+    string msg;
+
+    mede("otimizado", "escalar", ops, true, [&](size_t i) { multiplicacao_escalar(s.x[i], e.ks[i], P_0.x); });
+    mede("otimizado", "keygen", ops, true, [&](size_t) {
+        gera_escalar_rand(k);
+        multiplicacao_escalar_base(pub, k);
+    });
+    mede("otimizado", "codifica", ops, true, [&](size_t i) {
+        Ponto P = codifica_mensagem_para_ponto_da_c25519(e.msgs[i]);
+        mpz_set(s.x[i], P.x);
+        clearPonto(P);
+    });
+    mede("otimizado", "decodifica", ops, true, [&](size_t i) { decodifica_para_string(msg, k, s.x[i]); });
+    mede("otimizado", "encripta", ops, true, [&](size_t i) {
+        multiplicacao_escalar_base(s.C1[i], e.ks[i]);
+        multiplicacao_escalar(segredo, e.ks[i], e.pbl);
+        xor_chave(s.C2[i], s.x[i], s.C1[i], segredo);
+    });
+    mede("otimizado", "decripta", ops, true, [&](size_t i) {
+        multiplicacao_escalar(segredo, e.prv, s.C1[i]);
+        xor_chave(k, s.C2[i], s.C1[i], segredo);
+    });
+
+    mpz_clears(k, pub, segredo, NULL);
+}
+
+// ________________________Backend ntl: coordenadas afins com InvMod________________________
+#ifdef COM_NTL
+
+struct PontoNTL
+{
+    NTL::ZZ x, y;
+    bool infinito;
+};
+
+struct ParametrosNTL
+{
+    NTL::ZZ p, a;
+    PontoNTL G;
+};
+
+const ParametrosNTL &parametros_ntl()
+{
+    static const ParametrosNTL *c = []() {
+        ParametrosNTL *n = new ParametrosNTL;
+        n->p = NTL::conv<NTL::ZZ>("57896044618658097711785492504343953926634992332820282019728792003956564819949");
+        n->a = NTL::ZZ(486662);
+        n->G.x = NTL::ZZ(9);
+        n->G.y = NTL::conv<NTL::ZZ>("14781619447589544791020593568409986887264606134616475288964881837755586237401");
+        n->G.infinito = false;
+        return n;
+    }();
+    return *c;
+}
+
+NTL::ZZ mpz_para_zz(const mpz_t x)
+{
+    uint8_t b[64] = {0};
+    size_t n = 0;
+    mpz_export(b, &n, -1, 1, 0, 0, x);
+    return NTL::ZZFromBytes(b, (long)n);
+}
+
+void zz_para_mpz(mpz_t &r, const NTL::ZZ &x)
+{
+    uint8_t b[64] = {0};
+    long n = NTL::NumBytes(x);
+    NTL::BytesFromZZ(b, x, n);
+    mpz_import(r, (size_t)n, -1, 1, 0, 0, b);
+}
+
+// 2P em y² = x³ + a*x² + x: m = (3x² + 2ax + 1)/(2y), x3 = m² - a - 2x
+PontoNTL ntl_dobra(const PontoNTL &P)
+{
+    const ParametrosNTL &c = parametros_ntl();
+    if (P.infinito || NTL::IsZero(P.y))
+        return PontoNTL{NTL::ZZ(0), NTL::ZZ(0), true};
+    NTL::ZZ m = ((3 * P.x * P.x + 2 * c.a * P.x + 1) % c.p) * NTL::InvMod((2 * P.y) % c.p, c.p) % c.p;
+    PontoNTL R;
+    R.x = (m * m - c.a - 2 * P.x) % c.p;
+    R.y = (m * (P.x - R.x) - P.y) % c.p;
+    R.infinito = false;
+    return R;
+}
+
+// P + Q: m = (y2 - y1)/(x2 - x1), x3 = m² - a - x1 - x2
+PontoNTL ntl_soma(const PontoNTL &P, const PontoNTL &Q)
+{
+    const ParametrosNTL &c = parametros_ntl();
+    if (P.infinito)
+        return Q;
+    if (Q.infinito)
+        return P;
+    if (P.x == Q.x)
+        return (P.y == Q.y) ? ntl_dobra(P) : PontoNTL{NTL::ZZ(0), NTL::ZZ(0), true};
+    NTL::ZZ m = ((Q.y - P.y) % c.p) * NTL::InvMod((Q.x - P.x) % c.p, c.p) % c.p;
+    PontoNTL R;
+    R.x = (m * m - c.a - P.x - Q.x) % c.p;
+    R.y = (m * (P.x - R.x) - P.y) % c.p;
+    R.infinito = false;
+    return R;
+}
+
+// Duplica e soma da esquerda para a direita
+PontoNTL ntl_multiplicacao_escalar(const NTL::ZZ &k, const PontoNTL &P)
+{
+    PontoNTL R{NTL::ZZ(0), NTL::ZZ(0), true};
+    for (long i = NTL::NumBits(k) - 1; i >= 0; --i)
+    {
+        R = ntl_dobra(R);
+        if (NTL::bit(k, i))
+            R = ntl_soma(R, P);
+    }
+    return R;
+}
+
+// Codificacao de ECC_comparacao.cpp: Teste de Euler (PowerMod) e SqrRootMod
+PontoNTL ntl_codifica(const NTL::ZZ &msg)
+{
+    const ParametrosNTL &c = parametros_ntl();
+    NTL::ZZ x = 100 * msg, e = (c.p - 1) / 2;
+    while (true)
+    {
+        NTL::ZZ y2 = (((x + c.a) * x + 1) * x) % c.p;
+        if (NTL::PowerMod(y2, e, c.p) == 1)
+            return PontoNTL{x, NTL::SqrRootMod(y2, c.p), false};
+        x += 1;
+    }
+}
+
+// Mesmo caminho de decodifica_para_string: msg = x/100 e os seus bytes (little-endian)
+void ntl_decodifica_para_string(string &msg, const NTL::ZZ &x)
+{
+    NTL::ZZ m = x / 100;
+    msg.resize((size_t)NTL::NumBytes(m));
+    if (!msg.empty())
+        NTL::BytesFromZZ((unsigned char *)&msg[0], m, (long)msg.size());
+}
+
+void bench_ntl(const Entradas &e, Saidas &s)
+{
+    const size_t ops = e.ops;
+    const ParametrosNTL &c = parametros_ntl();
+    vector<NTL::ZZ> ks(ops), msgs(ops), xs(ops), C2(ops);
+    vector<PontoNTL> C1(ops);
+    for (size_t i = 0; i < ops; ++i)
+    {
+        ks[i] = mpz_para_zz(e.ks[i]);
+        msgs[i] = mpz_para_zz(e.msgs[i]);
+    }
+    NTL::ZZ prv = mpz_para_zz(e.prv);
+    PontoNTL pub = ntl_multiplicacao_escalar(prv, c.G);
+    mpz_t k, C1x, segredo, x;
+    mpz_inits(k, C1x, segredo, x, NULL);
+    string msg;
+
+    // Alocacoes do NTL nao passam pelo contador da GMP: alocs_op = null
+    mede("ntl", "escalar", ops, false, [&](size_t i) { ntl_multiplicacao_escalar(ks[i], c.G); });
+    mede("ntl", "keygen", ops, false, [&](size_t) {
+        gera_escalar_rand(k);
+        ntl_multiplicacao_escalar(mpz_para_zz(k), c.G);
+    });
+    mede("ntl", "codifica", ops, false, [&](size_t i) { xs[i] = ntl_codifica(msgs[i]).x; });
+    mede("ntl", "decodifica", ops, false, [&](size_t i) { ntl_decodifica_para_string(msg, xs[i]); });
+    mede("ntl", "encripta", ops, false, [&](size_t i) {
+        C1[i] = ntl_multiplicacao_escalar(ks[i], c.G);
+        PontoNTL S = ntl_multiplicacao_escalar(ks[i], pub);
+        zz_para_mpz(C1x, C1[i].x);
+        zz_para_mpz(segredo, S.x);
+        zz_para_mpz(x, xs[i]);
+        xor_chave(x, x, C1x, segredo);
+        C2[i] = mpz_para_zz(x);
+    });
+    mede("ntl", "decripta", ops, false, [&](size_t i) {
+        PontoNTL S = ntl_multiplicacao_escalar(prv, C1[i]);
+        zz_para_mpz(C1x, C1[i].x);
+        zz_para_mpz(segredo, S.x);
+        zz_para_mpz(x, C2[i]);
+        xor_chave(x, x, C1x, segredo);
+    });
+
+    mpz_clears(k, C1x, segredo, x, NULL);
+}
+
+// A coordenada x de k*G do NTL deve coincidir com a escada otimizada
+bool confere_ntl(const mpz_t k, const mpz_t esperado)
+{
+    PontoNTL R = ntl_multiplicacao_escalar(mpz_para_zz(k), parametros_ntl().G);
+    mpz_t x;
+    mpz_init(x);
+    if (R.infinito)
+        mpz_set_ui(x, 0);
+    else
+        zz_para_mpz(x, R.x);
+    bool ok = mpz_cmp(x, esperado) == 0;
+    mpz_clear(x);
+    return ok;
+}
+#endif // COM_NTL
+
+// Antes de medir: todos os backends calculam o mesmo k*P_0.x
+bool confere_backends(const Entradas &e)
+{
+    bool ok = true;
+    mpz_t r_gmp, r_opt;
+    mpz_inits(r_gmp, r_opt, NULL);
+    for (size_t i = 0; i < min(e.ops, (size_t)8); ++i)
+    {
+        gmp_multiplicacao_escalar(r_gmp, e.ks[i], P_0.x);
+        multiplicacao_escalar(r_opt, e.ks[i], P_0.x);
+        ok = ok && mpz_cmp(r_gmp, r_opt) == 0;
+#ifdef COM_NTL
+        ok = ok && confere_ntl(e.ks[i], r_opt);
+#endif
+    }
+    mpz_clears(r_gmp, r_opt, NULL);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    inic_contador_alocacoes(); // alocs/op (fora do autoteste e dos benchmarks o contador fica desligado)
+    inic_parametros_c25519();
+
+    size_t ops = 1000;
+    const char *json = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+            ops = (size_t)atol(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json = argv[++i];
+    }
+    if (ops < 2)
+        ops = 2;
+
+    Entradas e;
+    Saidas s;
+    inic_entradas(e, ops);
+    inic_saidas(s, ops);
+
+    if (!confere_backends(e))
+    {
+        cerr << "Backends discordam de k*P_0.x; resultados nao sao comparaveis" << endl;
+        return 1;
+    }
+
+    printf("%-10s %-12s %8s %12s %10s %10s %10s %10s %12s\n", "backend", "operacao", "ops", "ciclos/op", "p50 ns",
+           "p90 ns", "p99 ns", "alocs/op", "ops/s");
+    bench_gmp(e, s);
+#ifdef COM_NTL
+    bench_ntl(e, s);
+#else
+    printf("%-10s (nao compilado: -DCOM_NTL e -lntl)\n", "ntl");
+#endif
+    bench_otimizado(e, s);
+
+    if (json)
+        escreve_json(json, ops);
+
+    // Com -DECC_INSTRUMENTACAO: contadores acumulados de toda a suite (os tempos acima incluem o custo da instrumentacao)
+    if (INSTR_ATIVA)
+        instr_imprime(stderr, instr_snapshot());
+
+    limpa_saidas(s);
+    limpa_entradas(e);
+    return 0;
+}
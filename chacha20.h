@@ -0,0 +1,129 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Cifra de fluxo ChaCha20 (RFC 8439): chave de 256 bits, nonce de 96 bits e
+contador de blocos de 32 bits (ate 256 GB por par chave/nonce). Cada bloco
+de 64 bytes do fluxo de chave eh independente, entao a cifra processa
+entradas de qualquer tamanho em pedacos sem guardar nada alem do estado.
+____________________________________________________________________________*/
+
+#ifndef CHACHA20_H
+#define CHACHA20_H
+
+#include <stdint.h>
+#include <string.h>
+
+struct ChaCha20
+{
+    uint32_t estado[16]; // constantes | chave | contador | nonce
+    uint8_t fluxo[64];   // bloco corrente do fluxo de chave
+    size_t usados;       // bytes de 'fluxo' ja consumidos (64 = gerar outro)
+};
+
+inline uint32_t chacha20_le32(const uint8_t *b)
+{
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+inline uint32_t chacha20_rotl(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+#define CHACHA20_QR(a, b, c, d)                          \
+    a += b; d ^= a; d = chacha20_rotl(d, 16);            \
+    c += d; b ^= c; b = chacha20_rotl(b, 12);            \
+    a += b; d ^= a; d = chacha20_rotl(d, 8);             \
+    c += d; b ^= c; b = chacha20_rotl(b, 7);
+
+// Gera o bloco de 64 bytes para o estado atual (20 rodadas = 10 duplas)
+inline void chacha20_bloco(uint8_t saida[64], const uint32_t estado[16])
+{
+    uint32_t x[16];
+    memcpy(x, estado, sizeof(x));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        // colunas
+        CHACHA20_QR(x[0], x[4], x[8], x[12]);
+        CHACHA20_QR(x[1], x[5], x[9], x[13]);
+        CHACHA20_QR(x[2], x[6], x[10], x[14]);
+        CHACHA20_QR(x[3], x[7], x[11], x[15]);
+        // diagonais
+        CHACHA20_QR(x[0], x[5], x[10], x[15]);
+        CHACHA20_QR(x[1], x[6], x[11], x[12]);
+        CHACHA20_QR(x[2], x[7], x[8], x[13]);
+        CHACHA20_QR(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        uint32_t v = x[i] + estado[i];
+        saida[4 * i] = (uint8_t)v;
+        saida[4 * i + 1] = (uint8_t)(v >> 8);
+        saida[4 * i + 2] = (uint8_t)(v >> 16);
+        saida[4 * i + 3] = (uint8_t)(v >> 24);
+    }
+}
+
+inline void chacha20_inicia(ChaCha20 &c, const uint8_t chave[32], const uint8_t nonce[12], uint32_t contador)
+{
+    c.estado[0] = 0x61707865; // "expand 32-byte k"
+    c.estado[1] = 0x3320646e;
+    c.estado[2] = 0x79622d32;
+    c.estado[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i)
+        c.estado[4 + i] = chacha20_le32(chave + 4 * i);
+    c.estado[12] = contador;
+    for (int i = 0; i < 3; ++i)
+        c.estado[13 + i] = chacha20_le32(nonce + 4 * i);
+    c.usados = 64;
+}
+
+// saida = entrada XOR fluxo de chave; chamadas sucessivas continuam o fluxo
+// (saida pode ser igual a entrada)
+inline void chacha20_xor(ChaCha20 &c, uint8_t *saida, const uint8_t *entrada, size_t tam)
+{
+    // Resto do bloco anterior
+    while (tam > 0 && c.usados < 64)
+    {
+        *saida++ = *entrada++ ^ c.fluxo[c.usados++];
+        --tam;
+    }
+
+    // Blocos inteiros direto na saida
+    while (tam >= 64)
+    {
+        chacha20_bloco(c.fluxo, c.estado);
+        ++c.estado[12];
+        for (int i = 0; i < 64; ++i)
+            saida[i] = entrada[i] ^ c.fluxo[i];
+        saida += 64;
+        entrada += 64;
+        tam -= 64;
+    }
+
+    if (tam > 0)
+    {
+        chacha20_bloco(c.fluxo, c.estado);
+        ++c.estado[12];
+        c.usados = 0;
+        while (tam > 0)
+        {
+            *saida++ = *entrada++ ^ c.fluxo[c.usados++];
+            --tam;
+        }
+    }
+}
+
+// Apaga chave e fluxo de chave da memoria
+inline void chacha20_limpa(ChaCha20 &c)
+{
+    volatile uint8_t *v = (volatile uint8_t *)&c;
+    for (size_t i = 0; i < sizeof(c); ++i)
+        v[i] = 0;
+}
+
+#endif // CHACHA20_H
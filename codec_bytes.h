@@ -0,0 +1,120 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Conversao entre bytes e mpz_t em tempo linear, sempre little-endian (o byte i
+vale 256^i, mesma ordem do string_to_mpz original).
+    mensagens: copia direta para os limbs do mpz_t (mpz_import/mpz_export em
+               maquinas big-endian). Antes: 256^i e uma soma por caractere
+               na ida, divisoes sucessivas por 256 na volta, O(n²)
+    32 bytes:  chaves, escalares e segredos escritos direto nos limbs do mpz_t,
+               sem alocacao quando o destino ja tem 256 bits de capacidade
+    u:         coordenada u da RFC 7748 (bit 255 ignorado na leitura, forma
+               canonica mod p na escrita)
+____________________________________________________________________________*/
+
+#ifndef CODEC_BYTES_H
+#define CODEC_BYTES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <gmp.h>
+#include "fe25519.h"
+
+// x = b[0] + b[1]*256 + ... + b[tam-1]*256^(tam-1)
+// Em maquinas little-endian os bytes ja estao na ordem dos limbs: uma copia direta
+inline void bytes_para_mpz(mpz_t x, const uint8_t *b, size_t tam)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const size_t qtd = (tam + sizeof(mp_limb_t) - 1) / sizeof(mp_limb_t);
+    if (qtd == 0)
+    {
+        mpz_set_ui(x, 0);
+        return;
+    }
+    mp_limb_t *l = mpz_limbs_write(x, (mp_size_t)qtd);
+    l[qtd - 1] = 0; // completa o limb mais alto
+    memcpy(l, b, tam);
+    mpz_limbs_finish(x, (mp_size_t)qtd); // descarta limbs zero do topo
+#else
+    mpz_import(x, tam, -1, 1, 0, 0, b);
+#endif
+}
+
+// Bytes de x (x >= 0) do menos significativo ao mais significativo, sem zeros no fim
+inline size_t tam_bytes_mpz(const mpz_t x)
+{
+    return mpz_sgn(x) == 0 ? 0 : (mpz_sizeinbase(x, 2) + 7) / 8;
+}
+
+// Escreve tam_bytes_mpz(x) bytes em b e retorna essa quantidade
+inline size_t mpz_para_bytes(uint8_t *b, const mpz_t x)
+{
+    size_t tam = tam_bytes_mpz(x);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(b, mpz_limbs_read(x), tam);
+#else
+    mpz_export(b, NULL, -1, 1, 0, 0, x);
+#endif
+    return tam;
+}
+
+inline void string_para_mpz(mpz_t x, const std::string &s)
+{
+    bytes_para_mpz(x, (const uint8_t *)s.data(), s.size());
+}
+
+inline std::string mpz_para_string(const mpz_t x)
+{
+    std::string s(tam_bytes_mpz(x), '\0');
+    if (!s.empty())
+        mpz_para_bytes((uint8_t *)&s[0], x);
+    return s;
+}
+
+// ________________________Codificacoes fixas de 32 bytes________________________
+
+// x = 32 bytes little-endian, montados direto nos 4 limbs
+inline void bytes32_para_mpz(mpz_t x, const uint8_t b[32])
+{
+    mp_limb_t *l = mpz_limbs_write(x, 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t w = 0;
+        for (int j = 7; j >= 0; --j)
+            w = (w << 8) | b[8 * i + j];
+        l[i] = (mp_limb_t)w;
+    }
+    mpz_limbs_finish(x, 4); // descarta limbs zero do topo
+}
+
+// 32 bytes little-endian de x (0 <= x < 2^256), lendo os limbs sem copiar
+inline void mpz_para_bytes32(uint8_t b[32], const mpz_t x)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t w = mpz_getlimbn(x, i); // 0 para limbs alem do tamanho
+        for (int j = 0; j < 8; ++j)
+            b[8 * i + j] = (uint8_t)(w >> (8 * j));
+    }
+}
+
+// Coordenada u em 32 bytes na forma canonica (u mod p, bit 255 zerado)
+inline void u_para_bytes32(uint8_t b[32], const mpz_t u)
+{
+    fe25519 t;
+    fe_from_mpz(t, u);
+    fe_tobytes(b, t);
+}
+
+// Decodificacao da RFC 7748: ignora o bit 255 e aceita valores nao canonicos (reduz mod p)
+inline void bytes32_para_u(mpz_t u, const uint8_t b[32])
+{
+    fe25519 t;
+    fe_frombytes(t, b);
+    fe_to_mpz(u, t);
+}
+
+#endif // CODEC_BYTES_H
@@ -0,0 +1,139 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Gerador de numeros aleatorios criptografico (CSPRNG) por thread: ChaCha20
+semeado pelo getrandom(), com buffer de saida reabastecido em blocos.
+
+- Um unico getrandom() por thread (e por fork): as chaves seguintes saem do
+  buffer, sem abrir arquivo nem fazer chamada de sistema.
+- Apagamento rapido da chave (Bernstein, "fast-key-erasure"): cada
+  reabastecimento gera a proxima chave junto com os dados e apaga a anterior,
+  e os bytes entregues sao zerados no buffer. Quem ler a memoria depois nao
+  recupera saidas passadas.
+- Seguro com fork(): um tratador pthread_atfork avanca uma geracao global e o
+  filho ressemeia antes do primeiro uso, em vez de repetir o fluxo do pai.
+____________________________________________________________________________*/
+
+#ifndef CSPRNG_H
+#define CSPRNG_H
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <atomic>
+#include <pthread.h>
+#include <sys/random.h>
+#include "chacha20.h"
+#include "instrumentacao.h"
+
+static const size_t CSPRNG_TAM_BUFFER = 1024; // 16 blocos ChaCha20 por reabastecimento
+
+struct Csprng
+{
+    uint8_t chave[32];
+    uint8_t buffer[CSPRNG_TAM_BUFFER];
+    size_t disponiveis; // bytes ainda nao entregues, no fim do buffer
+    uint64_t geracao;   // geracao de fork em que a chave foi semeada (0 = nunca)
+};
+
+// Avancada no processo filho a cada fork(); comeca em 1 para distinguir de "nunca semeado"
+inline std::atomic<uint64_t> &csprng_geracao_fork()
+{
+    static std::atomic<uint64_t> geracao{1};
+    return geracao;
+}
+
+inline void csprng_apos_fork()
+{
+    csprng_geracao_fork().fetch_add(1, std::memory_order_relaxed);
+}
+
+// Preenche com a fonte do sistema; sem entropia nao ha como gerar chaves com seguranca
+inline void csprng_entropia(uint8_t *b, size_t tam)
+{
+    while (tam > 0)
+    {
+        ssize_t n = getrandom(b, tam, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+        {
+            perror("getrandom");
+            abort();
+        }
+        INSTR_SOMA(INSTR_BYTES_ENTROPIA, n);
+        b += n;
+        tam -= (size_t)n;
+    }
+}
+
+inline void csprng_semeia(Csprng &g)
+{
+    static const int registrado = pthread_atfork(NULL, NULL, csprng_apos_fork);
+    (void)registrado;
+
+    g.geracao = csprng_geracao_fork().load(std::memory_order_relaxed);
+    csprng_entropia(g.chave, sizeof(g.chave));
+    memset(g.buffer, 0, sizeof(g.buffer));
+    g.disponiveis = 0;
+}
+
+// Novo bloco de saida: os primeiros 32 bytes viram a proxima chave, o resto vai para o buffer
+inline void csprng_reabastece(Csprng &g)
+{
+    static const uint8_t nonce[12] = {0};
+    uint8_t fluxo[32 + CSPRNG_TAM_BUFFER] = {0};
+    ChaCha20 c;
+    chacha20_inicia(c, g.chave, nonce, 0);
+    chacha20_xor(c, fluxo, fluxo, sizeof(fluxo));
+    memcpy(g.chave, fluxo, 32);
+    memcpy(g.buffer, fluxo + 32, CSPRNG_TAM_BUFFER);
+    g.disponiveis = CSPRNG_TAM_BUFFER;
+    chacha20_limpa(c);
+    memset(fluxo, 0, sizeof(fluxo));
+}
+
+inline Csprng &csprng_thread()
+{
+    static thread_local Csprng g = {};
+    return g;
+}
+
+// Preenche 'saida' com tam bytes aleatorios do gerador da thread atual
+inline void csprng_bytes(uint8_t *saida, size_t tam)
+{
+    INSTR_SOMA(INSTR_BYTES_RNG, tam);
+    Csprng &g = csprng_thread();
+    if (g.geracao != csprng_geracao_fork().load(std::memory_order_relaxed))
+        csprng_semeia(g);
+
+    while (tam > 0)
+    {
+        if (g.disponiveis == 0)
+            csprng_reabastece(g);
+        size_t n = tam < g.disponiveis ? tam : g.disponiveis;
+        uint8_t *origem = g.buffer + CSPRNG_TAM_BUFFER - g.disponiveis;
+        memcpy(saida, origem, n);
+        memset(origem, 0, n);
+        g.disponiveis -= n;
+        saida += n;
+        tam -= n;
+    }
+}
+
+// Escalar X25519 com o "clamping" da RFC 7748 (sec. 5): multiplo de 8 (anula o
+// cofator) e bit 254 ligado (numero fixo de passos da escada). Toda sequencia de
+// 32 bytes vira uma chave valida, sem laco de rejeicao.
+inline void csprng_escalar_x25519(uint8_t k[32])
+{
+    csprng_bytes(k, 32);
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+}
+
+#endif // CSPRNG_H
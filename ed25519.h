@@ -0,0 +1,238 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Assinaturas Ed25519 (RFC 8032) sobre o grupo de ge25519.h e o SHA-512 de
+sha512.h. A verificacao usa a equacao com cofator, [8]([S]B - [k]A - R) = 0,
+tanto na verificacao individual quanto em lote, para que as duas sempre
+concordem (mesmo com chaves ou R de ordem pequena).
+
+Verificacao em lote: com coeficientes aleatorios z_i de 128 bits,
+    [8]( sum z_i*R_i + sum (z_i*k_i)*A_i - (sum z_i*S_i)*B ) = 0
+e a soma eh uma unica multiplicacao multi-escalar (Pippenger) com 2N + 1 pontos.
+
+A aritmetica modulo L (ordem do subgrupo) usa GMP; assim como o restante do
+programa, ela nao eh em tempo constante. A multiplicacao secreta r*B usa a
+tabela da base em tempo constante.
+____________________________________________________________________________*/
+
+#ifndef ED25519_H
+#define ED25519_H
+
+#include <vector>
+#include "ge25519.h"
+#include "sha512.h"
+#include "csprng.h" // coeficientes aleatorios do lote
+
+// L = 2^252 + 27742317777372353535851937790883648493
+inline const __mpz_struct *sc_ordem()
+{
+    static mpz_t L;
+    static const bool iniciado = []() {
+        mpz_init_set_str(L, "1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed", 16);
+        return true;
+    }();
+    (void)iniciado;
+    return L;
+}
+
+// 32 bytes little-endian de x (0 <= x < 2^256)
+inline void sc_exporta(uint8_t s[32], const mpz_t x)
+{
+    memset(s, 0, 32);
+    mpz_export(s, NULL, -1, 1, -1, 0, x);
+}
+
+// s = h mod L, h com 'tam' bytes little-endian (ex.: 64 bytes do SHA-512)
+inline void sc_reduz(uint8_t s[32], const uint8_t *h, size_t tam)
+{
+    mpz_t x;
+    mpz_init(x);
+    mpz_import(x, tam, -1, 1, 0, 0, h);
+    mpz_mod(x, x, sc_ordem());
+    sc_exporta(s, x);
+    mpz_clear(x);
+}
+
+// s = a*b + c mod L
+inline void sc_muladd(uint8_t s[32], const uint8_t a[32], const uint8_t b[32], const uint8_t c[32])
+{
+    mpz_t x, y;
+    mpz_inits(x, y, NULL);
+    mpz_import(x, 32, -1, 1, 0, 0, a);
+    mpz_import(y, 32, -1, 1, 0, 0, b);
+    mpz_mul(x, x, y);
+    mpz_import(y, 32, -1, 1, 0, 0, c);
+    mpz_add(x, x, y);
+    mpz_mod(x, x, sc_ordem());
+    sc_exporta(s, x);
+    mpz_clears(x, y, NULL);
+}
+
+// 1 se s < L (RFC 8032 exige S canonico para evitar maleabilidade)
+inline bool sc_canonico(const uint8_t s[32])
+{
+    mpz_t x;
+    mpz_init(x);
+    mpz_import(x, 32, -1, 1, 0, 0, s);
+    bool ok = mpz_cmp(x, sc_ordem()) < 0;
+    mpz_clear(x);
+    return ok;
+}
+
+// Expande a chave privada (semente de 32 bytes): a = clamp(H[0..31]), prefixo = H[32..63]
+inline void ed25519_expande(uint8_t a[32], uint8_t prefixo[32], const uint8_t sk[32])
+{
+    uint8_t h[SHA512_TAM_HASH];
+    sha512(h, sk, 32);
+    h[0] &= 248;
+    h[31] &= 127;
+    h[31] |= 64;
+    memcpy(a, h, 32);
+    memcpy(prefixo, h + 32, 32);
+    memset(h, 0, sizeof(h));
+}
+
+inline void ed25519_chave_publica(uint8_t pk[32], const uint8_t sk[32])
+{
+    uint8_t a[32], prefixo[32];
+    ge_p3 A;
+    ed25519_expande(a, prefixo, sk);
+    ge_scalarmult_base(A, a);
+    ge_p3_tobytes(pk, A);
+    memset(a, 0, sizeof(a));
+    memset(prefixo, 0, sizeof(prefixo));
+}
+
+// k = SHA-512(R | A | M) mod L
+inline void ed25519_desafio(uint8_t k[32], const uint8_t R[32], const uint8_t pk[32], const uint8_t *m, size_t tam)
+{
+    uint8_t h[SHA512_TAM_HASH];
+    Sha512 s;
+    sha512_inicia(s);
+    sha512_atualiza(s, R, 32);
+    sha512_atualiza(s, pk, 32);
+    sha512_atualiza(s, m, tam);
+    sha512_finaliza(s, h);
+    sc_reduz(k, h, sizeof(h));
+}
+
+// assinatura = R | S, r = H(prefixo | M) mod L, R = r*B, S = r + k*a mod L
+inline void ed25519_assina(uint8_t assinatura[64], const uint8_t *m, size_t tam, const uint8_t sk[32], const uint8_t pk[32])
+{
+    uint8_t a[32], prefixo[32], h[SHA512_TAM_HASH], r[32], k[32];
+    ge_p3 R;
+    Sha512 s;
+
+    ed25519_expande(a, prefixo, sk);
+
+    sha512_inicia(s);
+    sha512_atualiza(s, prefixo, 32);
+    sha512_atualiza(s, m, tam);
+    sha512_finaliza(s, h);
+    sc_reduz(r, h, sizeof(h));
+
+    ge_scalarmult_base(R, r);
+    ge_p3_tobytes(assinatura, R);
+
+    ed25519_desafio(k, assinatura, pk, m, tam);
+    sc_muladd(assinatura + 32, k, a, r);
+
+    memset(a, 0, sizeof(a));
+    memset(prefixo, 0, sizeof(prefixo));
+    memset(r, 0, sizeof(r));
+}
+
+// Verificacao individual: [8]([S]B - [k]A - R) = 0, com S*B - k*A numa unica passada (Straus)
+inline bool ed25519_verifica(const uint8_t assinatura[64], const uint8_t *m, size_t tam, const uint8_t pk[32])
+{
+    ge_p3 A, R, P;
+    ge_cached R_c;
+    ge_p1p1 t;
+    uint8_t k[32];
+
+    if (!sc_canonico(assinatura + 32) || !ge_frombytes(A, pk) || !ge_frombytes(R, assinatura))
+        return false;
+
+    ed25519_desafio(k, assinatura, pk, m, tam);
+
+    ge_p3_neg(A, A);
+    ge_double_scalarmult_vartime(P, k, A, assinatura + 32);
+
+    ge_p3_to_cached(R_c, R);
+    ge_sub(t, P, R_c);
+    ge_p1p1_to_p3(P, t);
+    ge_p3_mul8(P, P);
+    return ge_p3_eh_neutro(P);
+}
+
+// Verifica qtd assinaturas de uma vez. Retorna true se todas sao validas.
+// Se 'validas' != NULL, preenche o resultado de cada uma (quando o lote falha,
+// recorre a verificacao individual para achar as invalidas).
+inline bool ed25519_verifica_lote(const uint8_t *const msgs[], const size_t tams[], const uint8_t *const assinaturas[],
+                                  const uint8_t *const chaves[], size_t qtd, bool *validas = NULL)
+{
+    std::vector<uint8_t> z(16 * qtd);
+    uint8_t (*escalares)[32] = new uint8_t[2 * qtd + 1][32];
+    std::vector<ge_p3> pontos(2 * qtd + 1);
+    bool ok = true;
+
+    // Coeficientes aleatorios z_i de 128 bits (imprevisiveis para quem montou o lote)
+    csprng_bytes(z.data(), z.size());
+
+    mpz_t soma_zs, zi, x;
+    mpz_inits(soma_zs, zi, x, NULL);
+    for (size_t i = 0; i < qtd && ok; ++i)
+    {
+        ge_p3 A, R;
+        uint8_t k[32];
+        if (!sc_canonico(assinaturas[i] + 32) || !ge_frombytes(A, chaves[i]) || !ge_frombytes(R, assinaturas[i]))
+        {
+            ok = false;
+            break;
+        }
+        ed25519_desafio(k, assinaturas[i], chaves[i], msgs[i], tams[i]);
+
+        mpz_import(zi, 16, -1, 1, 0, 0, &z[16 * i]);
+
+        // R_i com coeficiente z_i
+        sc_exporta(escalares[2 * i], zi);
+        pontos[2 * i] = R;
+
+        // A_i com coeficiente z_i*k_i mod L
+        mpz_import(x, 32, -1, 1, 0, 0, k);
+        mpz_mul(x, x, zi);
+        mpz_mod(x, x, sc_ordem());
+        sc_exporta(escalares[2 * i + 1], x);
+        pontos[2 * i + 1] = A;
+
+        // sum z_i*S_i
+        mpz_import(x, 32, -1, 1, 0, 0, assinaturas[i] + 32);
+        mpz_addmul(soma_zs, x, zi);
+    }
+
+    if (ok)
+    {
+        // B com coeficiente -(sum z_i*S_i) mod L
+        ge_p3 P;
+        mpz_mod(soma_zs, soma_zs, sc_ordem());
+        mpz_sub(soma_zs, sc_ordem(), soma_zs);
+        mpz_mod(soma_zs, soma_zs, sc_ordem());
+        sc_exporta(escalares[2 * qtd], soma_zs);
+        ge_base(pontos[2 * qtd]);
+
+        ge_multiescalar_vartime(P, escalares, pontos.data(), 2 * qtd + 1);
+        ge_p3_mul8(P, P);
+        ok = ge_p3_eh_neutro(P);
+    }
+    mpz_clears(soma_zs, zi, x, NULL);
+    delete[] escalares;
+
+    if (validas)
+        for (size_t i = 0; i < qtd; ++i)
+            validas[i] = ok || ed25519_verifica(assinaturas[i], msgs[i], tams[i], chaves[i]);
+    return ok;
+}
+
+#endif // ED25519_H
@@ -0,0 +1,395 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Elemento do corpo GF(2^255 - 19) em radix 2^51 (cinco limbs de 51 bits).
+Substitui o mpz_t no laco de Montgomery: tudo fica na pilha, sem malloc,
+e a reducao explora a forma especial do primo (2^255 = 19 mod p).
+____________________________________________________________________________*/
+
+#ifndef FE25519_H
+#define FE25519_H
+
+#include <stdint.h>
+#include <string.h>
+#include <gmp.h>
+#include "instrumentacao.h"
+
+static_assert(GMP_NUMB_BITS == 64, "fe25519 assume limbs GMP de 64 bits");
+
+typedef unsigned __int128 uint128_t;
+
+// f = v[0] + v[1]*2^51 + v[2]*2^102 + v[3]*2^153 + v[4]*2^204
+// Apos fe_carry/fe_mul/fe_sq cada limb fica abaixo de 2^52 (representacao nao unica)
+struct fe25519
+{
+    uint64_t v[5];
+};
+
+static const uint64_t FE_MASCARA_51 = (1ULL << 51) - 1;
+
+inline void fe_0(fe25519 &h)
+{
+    h.v[0] = h.v[1] = h.v[2] = h.v[3] = h.v[4] = 0;
+}
+
+inline void fe_1(fe25519 &h)
+{
+    h.v[0] = 1;
+    h.v[1] = h.v[2] = h.v[3] = h.v[4] = 0;
+}
+
+inline void fe_set_ui(fe25519 &h, uint64_t x)
+{
+    fe_0(h);
+    h.v[0] = x & FE_MASCARA_51;
+    h.v[1] = x >> 51;
+}
+
+// Propaga os carries (reducao fraca): 2^255 = 19 mod p
+inline void fe_carry(fe25519 &h)
+{
+    uint64_t c;
+    c = h.v[0] >> 51; h.v[0] &= FE_MASCARA_51; h.v[1] += c;
+    c = h.v[1] >> 51; h.v[1] &= FE_MASCARA_51; h.v[2] += c;
+    c = h.v[2] >> 51; h.v[2] &= FE_MASCARA_51; h.v[3] += c;
+    c = h.v[3] >> 51; h.v[3] &= FE_MASCARA_51; h.v[4] += c;
+    c = h.v[4] >> 51; h.v[4] &= FE_MASCARA_51; h.v[0] += c * 19;
+}
+
+// h = f + g (sem carry, limbs de entrada < 2^52)
+inline void fe_add(fe25519 &h, const fe25519 &f, const fe25519 &g)
+{
+    for (int i = 0; i < 5; ++i)
+        h.v[i] = f.v[i] + g.v[i];
+}
+
+// h = f - g, soma 4p antes para nunca ficar negativo
+inline void fe_sub(fe25519 &h, const fe25519 &f, const fe25519 &g)
+{
+    h.v[0] = (f.v[0] + 0x1FFFFFFFFFFFB4ULL) - g.v[0];
+    h.v[1] = (f.v[1] + 0x1FFFFFFFFFFFFCULL) - g.v[1];
+    h.v[2] = (f.v[2] + 0x1FFFFFFFFFFFFCULL) - g.v[2];
+    h.v[3] = (f.v[3] + 0x1FFFFFFFFFFFFCULL) - g.v[3];
+    h.v[4] = (f.v[4] + 0x1FFFFFFFFFFFFCULL) - g.v[4];
+    fe_carry(h);
+}
+
+// Reducao dos produtos de 128 bits: r[i] ja contem os termos 19*f[j]*g[k] com j + k >= 5
+inline void fe_reduz_128(fe25519 &h, uint128_t r0, uint128_t r1, uint128_t r2, uint128_t r3, uint128_t r4)
+{
+    uint64_t c;
+    r1 += (uint64_t)(r0 >> 51); h.v[0] = (uint64_t)r0 & FE_MASCARA_51;
+    r2 += (uint64_t)(r1 >> 51); h.v[1] = (uint64_t)r1 & FE_MASCARA_51;
+    r3 += (uint64_t)(r2 >> 51); h.v[2] = (uint64_t)r2 & FE_MASCARA_51;
+    r4 += (uint64_t)(r3 >> 51); h.v[3] = (uint64_t)r3 & FE_MASCARA_51;
+    c = (uint64_t)(r4 >> 51);   h.v[4] = (uint64_t)r4 & FE_MASCARA_51;
+    h.v[0] += c * 19;
+    c = h.v[0] >> 51; h.v[0] &= FE_MASCARA_51; h.v[1] += c;
+}
+
+// h = f * g mod p
+inline void fe_mul(fe25519 &h, const fe25519 &f, const fe25519 &g)
+{
+    INSTR_CONTA(INSTR_MUL_CORPO);
+    const uint64_t f0 = f.v[0], f1 = f.v[1], f2 = f.v[2], f3 = f.v[3], f4 = f.v[4];
+    const uint64_t g0 = g.v[0], g1 = g.v[1], g2 = g.v[2], g3 = g.v[3], g4 = g.v[4];
+    const uint64_t g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4;
+
+    uint128_t r0 = (uint128_t)f0 * g0 + (uint128_t)f1 * g4_19 + (uint128_t)f2 * g3_19 + (uint128_t)f3 * g2_19 + (uint128_t)f4 * g1_19;
+    uint128_t r1 = (uint128_t)f0 * g1 + (uint128_t)f1 * g0    + (uint128_t)f2 * g4_19 + (uint128_t)f3 * g3_19 + (uint128_t)f4 * g2_19;
+    uint128_t r2 = (uint128_t)f0 * g2 + (uint128_t)f1 * g1    + (uint128_t)f2 * g0    + (uint128_t)f3 * g4_19 + (uint128_t)f4 * g3_19;
+    uint128_t r3 = (uint128_t)f0 * g3 + (uint128_t)f1 * g2    + (uint128_t)f2 * g1    + (uint128_t)f3 * g0    + (uint128_t)f4 * g4_19;
+    uint128_t r4 = (uint128_t)f0 * g4 + (uint128_t)f1 * g3    + (uint128_t)f2 * g2    + (uint128_t)f3 * g1    + (uint128_t)f4 * g0;
+
+    fe_reduz_128(h, r0, r1, r2, r3, r4);
+}
+
+// h = f² mod p (aproveita a simetria dos produtos cruzados)
+inline void fe_sq(fe25519 &h, const fe25519 &f)
+{
+    INSTR_CONTA(INSTR_QUAD_CORPO);
+    const uint64_t f0 = f.v[0], f1 = f.v[1], f2 = f.v[2], f3 = f.v[3], f4 = f.v[4];
+    const uint64_t f0_2 = 2 * f0, f1_2 = 2 * f1;
+    const uint64_t f1_38 = 38 * f1, f2_38 = 38 * f2, f3_38 = 38 * f3;
+    const uint64_t f3_19 = 19 * f3, f4_19 = 19 * f4;
+
+    uint128_t r0 = (uint128_t)f0 * f0   + (uint128_t)f1_38 * f4 + (uint128_t)f2_38 * f3;
+    uint128_t r1 = (uint128_t)f0_2 * f1 + (uint128_t)f2_38 * f4 + (uint128_t)f3_19 * f3;
+    uint128_t r2 = (uint128_t)f0_2 * f2 + (uint128_t)f1 * f1    + (uint128_t)f3_38 * f4;
+    uint128_t r3 = (uint128_t)f0_2 * f3 + (uint128_t)f1_2 * f2  + (uint128_t)f4_19 * f4;
+    uint128_t r4 = (uint128_t)f0_2 * f4 + (uint128_t)f1_2 * f3  + (uint128_t)f2 * f2;
+
+    fe_reduz_128(h, r0, r1, r2, r3, r4);
+}
+
+// h = f^(2^n) mod p
+inline void fe_sq_n(fe25519 &h, const fe25519 &f, int n)
+{
+    fe_sq(h, f);
+    for (int i = 1; i < n; ++i)
+        fe_sq(h, h);
+}
+
+// h = f * c mod p, c pequeno (ex.: a24 = 121666)
+inline void fe_mul_ui(fe25519 &h, const fe25519 &f, uint32_t c)
+{
+    uint128_t r0 = (uint128_t)f.v[0] * c;
+    uint128_t r1 = (uint128_t)f.v[1] * c;
+    uint128_t r2 = (uint128_t)f.v[2] * c;
+    uint128_t r3 = (uint128_t)f.v[3] * c;
+    uint128_t r4 = (uint128_t)f.v[4] * c;
+
+    fe_reduz_128(h, r0, r1, r2, r3, r4);
+}
+
+// h = z^(p-2) mod p (Pequeno Teorema de Fermat), cadeia fixa de 254 quadrados e 11 multiplicacoes
+inline void fe_invert(fe25519 &h, const fe25519 &z)
+{
+    INSTR_CONTA(INSTR_INV_CORPO);
+    fe25519 z2, z9, z11, z2_5_0, z2_10_0, z2_20_0, z2_50_0, z2_100_0, t;
+
+    fe_sq(z2, z);                       // 2
+    fe_sq_n(t, z2, 2);                  // 8
+    fe_mul(z9, t, z);                   // 9
+    fe_mul(z11, z9, z2);                // 11
+    fe_sq(t, z11);                      // 22
+    fe_mul(z2_5_0, t, z9);              // 2^5 - 2^0
+    fe_sq_n(t, z2_5_0, 5);
+    fe_mul(z2_10_0, t, z2_5_0);         // 2^10 - 2^0
+    fe_sq_n(t, z2_10_0, 10);
+    fe_mul(z2_20_0, t, z2_10_0);        // 2^20 - 2^0
+    fe_sq_n(t, z2_20_0, 20);
+    fe_mul(t, t, z2_20_0);              // 2^40 - 2^0
+    fe_sq_n(t, t, 10);
+    fe_mul(z2_50_0, t, z2_10_0);        // 2^50 - 2^0
+    fe_sq_n(t, z2_50_0, 50);
+    fe_mul(z2_100_0, t, z2_50_0);       // 2^100 - 2^0
+    fe_sq_n(t, z2_100_0, 100);
+    fe_mul(t, t, z2_100_0);             // 2^200 - 2^0
+    fe_sq_n(t, t, 50);
+    fe_mul(t, t, z2_50_0);              // 2^250 - 2^0
+    fe_sq_n(t, t, 5);                   // 2^255 - 2^5
+    fe_mul(h, t, z11);                  // 2^255 - 21 = p - 2
+}
+
+// h = z^((p-5)/8) = z^(2^252 - 3), base das raizes quadradas (p = 5 mod 8)
+inline void fe_pow22523(fe25519 &h, const fe25519 &z)
+{
+    INSTR_CONTA(INSTR_EXP_MODULAR);
+    fe25519 t0, t1, t2;
+
+    fe_sq(t0, z);                       // 2
+    fe_sq_n(t1, t0, 2);                 // 8
+    fe_mul(t1, z, t1);                  // 9
+    fe_mul(t0, t0, t1);                 // 11
+    fe_sq(t0, t0);                      // 22
+    fe_mul(t0, t1, t0);                 // 2^5 - 2^0
+    fe_sq_n(t1, t0, 5);
+    fe_mul(t0, t1, t0);                 // 2^10 - 2^0
+    fe_sq_n(t1, t0, 10);
+    fe_mul(t1, t1, t0);                 // 2^20 - 2^0
+    fe_sq_n(t2, t1, 20);
+    fe_mul(t1, t2, t1);                 // 2^40 - 2^0
+    fe_sq_n(t1, t1, 10);
+    fe_mul(t0, t1, t0);                 // 2^50 - 2^0
+    fe_sq_n(t1, t0, 50);
+    fe_mul(t1, t1, t0);                 // 2^100 - 2^0
+    fe_sq_n(t2, t1, 100);
+    fe_mul(t1, t2, t1);                 // 2^200 - 2^0
+    fe_sq_n(t1, t1, 50);
+    fe_mul(t0, t1, t0);                 // 2^250 - 2^0
+    fe_sq_n(t0, t0, 2);                 // 2^252 - 2^2
+    fe_mul(h, t0, z);                   // 2^252 - 3
+}
+
+// Troca f e g se bit = 1, sem desvio dependente do segredo (constant-time)
+inline void fe_cswap(fe25519 &f, fe25519 &g, uint64_t bit)
+{
+    const uint64_t mascara = 0 - bit;
+    for (int i = 0; i < 5; ++i)
+    {
+        uint64_t x = (f.v[i] ^ g.v[i]) & mascara;
+        f.v[i] ^= x;
+        g.v[i] ^= x;
+    }
+}
+
+// f = g se bit = 1, sem desvio (constant-time)
+inline void fe_cmov(fe25519 &f, const fe25519 &g, uint64_t bit)
+{
+    const uint64_t mascara = 0 - bit;
+    for (int i = 0; i < 5; ++i)
+        f.v[i] ^= (f.v[i] ^ g.v[i]) & mascara;
+}
+
+// Serializa na forma canonica [0, p-1], 32 bytes little-endian (RFC 7748)
+inline void fe_tobytes(uint8_t s[32], const fe25519 &f)
+{
+    fe25519 h = f;
+    fe_carry(h);
+    fe_carry(h);
+
+    // q = 1 se h >= p, calculado sem desvio
+    uint64_t q = (h.v[0] + 19) >> 51;
+    q = (h.v[1] + q) >> 51;
+    q = (h.v[2] + q) >> 51;
+    q = (h.v[3] + q) >> 51;
+    q = (h.v[4] + q) >> 51;
+
+    h.v[0] += 19 * q;
+    uint64_t c;
+    c = h.v[0] >> 51; h.v[0] &= FE_MASCARA_51; h.v[1] += c;
+    c = h.v[1] >> 51; h.v[1] &= FE_MASCARA_51; h.v[2] += c;
+    c = h.v[2] >> 51; h.v[2] &= FE_MASCARA_51; h.v[3] += c;
+    c = h.v[3] >> 51; h.v[3] &= FE_MASCARA_51; h.v[4] += c;
+    h.v[4] &= FE_MASCARA_51;
+
+    const uint64_t w0 = h.v[0] | (h.v[1] << 51);
+    const uint64_t w1 = (h.v[1] >> 13) | (h.v[2] << 38);
+    const uint64_t w2 = (h.v[2] >> 26) | (h.v[3] << 25);
+    const uint64_t w3 = (h.v[3] >> 39) | (h.v[4] << 12);
+    const uint64_t w[4] = {w0, w1, w2, w3};
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 8; ++j)
+            s[8 * i + j] = (uint8_t)(w[i] >> (8 * j));
+}
+
+// Retorna 1 se f = 0 mod p, 0 caso contrario (sem desvio)
+inline uint64_t fe_iszero(const fe25519 &f)
+{
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    uint64_t acc = 0;
+    for (int i = 0; i < 32; ++i)
+        acc |= s[i];
+    return ((acc - 1) >> 63) & 1;
+}
+
+// Retorna o bit menos significativo da forma canonica ("sinal" de f)
+inline uint64_t fe_isnegative(const fe25519 &f)
+{
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    return s[0] & 1;
+}
+
+// h = -f
+inline void fe_neg(fe25519 &h, const fe25519 &f)
+{
+    fe25519 zero;
+    fe_0(zero);
+    fe_sub(h, zero, f);
+}
+
+// Retorna 1 se f = g mod p (sem desvio)
+inline uint64_t fe_iguais(const fe25519 &f, const fe25519 &g)
+{
+    fe25519 d;
+    fe_sub(d, f, g);
+    return fe_iszero(d);
+}
+
+// sqrt(-1) = 2^((p-1)/4) mod p
+inline const fe25519 &fe_sqrtm1()
+{
+    static const fe25519 i = []() {
+        fe25519 dois, t, r;
+        fe_set_ui(dois, 2);
+        fe_pow22523(t, dois); // 2^((p-5)/8)
+        fe_sq(t, t);          // 2^((p-5)/4)
+        fe_mul(r, t, dois);   // 2^((p-1)/4)
+        return r;
+    }();
+    return i;
+}
+
+// Raiz quadrada para p = 5 mod 8 com uma unica exponenciacao (Atkin/Legendre):
+// b = a^((p+3)/8); se b² = a, h = b; se b² = -a, h = b*sqrt(-1); senao a nao eh residuo.
+// Retorna 1 se a eh quadrado (h valido), 0 caso contrario. Sem desvios dependentes de a.
+inline uint64_t fe_sqrt(fe25519 &h, const fe25519 &a)
+{
+    fe25519 b, b2, menos_a, bi;
+
+    fe_pow22523(b, a);
+    fe_mul(b, b, a);                    // a^((p+3)/8)
+    fe_sq(b2, b);
+    fe_neg(menos_a, a);
+
+    const uint64_t direto = fe_iguais(b2, a);
+    const uint64_t com_i = fe_iguais(b2, menos_a);
+
+    fe_mul(bi, b, fe_sqrtm1());
+    fe_cmov(b, bi, com_i);
+    h = b;
+    return direto | com_i;
+}
+
+// h = sqrt(u/v) sem inversao separada: r = u*v^3*(u*v^7)^((p-5)/8) e depois a
+// mesma correcao por sqrt(-1) de fe_sqrt. Retorna 1 se u/v eh quadrado (v != 0).
+inline uint64_t fe_sqrt_razao(fe25519 &h, const fe25519 &u, const fe25519 &v)
+{
+    fe25519 v3, v7, r, teste, menos_u, ri;
+
+    fe_sq(v3, v);
+    fe_mul(v3, v3, v);                  // v^3
+    fe_sq(v7, v3);
+    fe_mul(v7, v7, v);                  // v^7
+    fe_mul(r, u, v7);
+    fe_pow22523(r, r);                  // (u*v^7)^((p-5)/8)
+    fe_mul(r, r, v3);
+    fe_mul(r, r, u);                    // u*v^3*(u*v^7)^((p-5)/8)
+
+    fe_sq(teste, r);
+    fe_mul(teste, teste, v);            // v*r^2 = +-u se u/v eh quadrado
+    fe_neg(menos_u, u);
+
+    const uint64_t direto = fe_iguais(teste, u);
+    const uint64_t com_i = fe_iguais(teste, menos_u);
+
+    fe_mul(ri, r, fe_sqrtm1());
+    fe_cmov(r, ri, com_i);
+    h = r;
+    return (direto | com_i) & (1 - fe_iszero(v));
+}
+
+// Le 32 bytes little-endian, ignorando o bit 255 (RFC 7748)
+inline void fe_frombytes(fe25519 &h, const uint8_t s[32])
+{
+    uint64_t w[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        w[i] = 0;
+        for (int j = 0; j < 8; ++j)
+            w[i] |= (uint64_t)s[8 * i + j] << (8 * j);
+    }
+    h.v[0] = w[0] & FE_MASCARA_51;
+    h.v[1] = ((w[0] >> 51) | (w[1] << 13)) & FE_MASCARA_51;
+    h.v[2] = ((w[1] >> 38) | (w[2] << 26)) & FE_MASCARA_51;
+    h.v[3] = ((w[2] >> 25) | (w[3] << 39)) & FE_MASCARA_51;
+    h.v[4] = (w[3] >> 12) & FE_MASCARA_51;
+}
+
+// Converte mpz_t -> fe25519 lendo os 4 limbs menos significativos direto (sem alocacao)
+inline void fe_from_mpz(fe25519 &h, const mpz_t x)
+{
+    uint8_t s[32];
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t w = mpz_getlimbn(x, i); // retorna 0 para limbs alem do tamanho
+        for (int j = 0; j < 8; ++j)
+            s[8 * i + j] = (uint8_t)(w >> (8 * j));
+    }
+    fe_frombytes(h, s);
+}
+
+// Converte fe25519 -> mpz_t na forma canonica
+inline void fe_to_mpz(mpz_t x, const fe25519 &f)
+{
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    mpz_import(x, 32, -1, 1, 0, 0, s);
+}
+
+#endif // FE25519_H
@@ -0,0 +1,209 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Quatro elementos de GF(2^255 - 19) processados juntos em registradores AVX2.
+O AVX2 so multiplica 32x32 -> 64 bits (vpmuludq), entao cada elemento usa
+radix 2^25.5 (10 limbs alternando 26 e 25 bits) e cada lane de 64 bits guarda
+o limb de uma escada independente:
+    f = f0 + f1*2^26 + f2*2^51 + f3*2^77 + ... + f9*2^230
+
+As funcoes sao compiladas com target("avx2"), sem exigir -mavx2 no resto do
+programa; quem chama deve checar cpu_suporta_avx2() antes.
+____________________________________________________________________________*/
+
+#ifndef FE25519_AVX2_H
+#define FE25519_AVX2_H
+
+#include <immintrin.h>
+#include "fe25519.h"
+
+#define FE_AVX2 __attribute__((target("avx2")))
+
+// Limb i dos 4 elementos (lane l = elemento l)
+struct fe25519x4
+{
+    __m256i v[10];
+};
+
+// Deteccao em tempo de execucao (CPUID + suporte do SO ao estado AVX)
+inline bool cpu_suporta_avx2()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+FE_AVX2 inline __m256i fe4_vezes19(__m256i c)
+{
+    return _mm256_add_epi64(_mm256_add_epi64(_mm256_slli_epi64(c, 4), _mm256_slli_epi64(c, 1)), c);
+}
+
+// Propaga os carries: limbs pares < 2^26, impares < 2^25 (mais um residuo pequeno no limb 1)
+FE_AVX2 inline void fe4_carry(fe25519x4 &h)
+{
+    const __m256i m26 = _mm256_set1_epi64x((1 << 26) - 1);
+    const __m256i m25 = _mm256_set1_epi64x((1 << 25) - 1);
+    __m256i c;
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 9; ++i)
+    {
+        c = (i & 1) ? _mm256_srli_epi64(h.v[i], 25) : _mm256_srli_epi64(h.v[i], 26);
+        h.v[i] = _mm256_and_si256(h.v[i], (i & 1) ? m25 : m26);
+        h.v[i + 1] = _mm256_add_epi64(h.v[i + 1], c);
+    }
+    c = _mm256_srli_epi64(h.v[9], 25);
+    h.v[9] = _mm256_and_si256(h.v[9], m25);
+    h.v[0] = _mm256_add_epi64(h.v[0], fe4_vezes19(c));
+
+    c = _mm256_srli_epi64(h.v[0], 26);
+    h.v[0] = _mm256_and_si256(h.v[0], m26);
+    h.v[1] = _mm256_add_epi64(h.v[1], c);
+}
+
+// h = f + g (sem carry, limbs resultantes < 2^27)
+FE_AVX2 inline void fe4_add(fe25519x4 &h, const fe25519x4 &f, const fe25519x4 &g)
+{
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+        h.v[i] = _mm256_add_epi64(f.v[i], g.v[i]);
+}
+
+// h = f - g + 4p (g com carry aplicado)
+FE_AVX2 inline void fe4_sub(fe25519x4 &h, const fe25519x4 &f, const fe25519x4 &g)
+{
+    const __m256i p4_0 = _mm256_set1_epi64x(0xFFFFFB4);    // 4*(2^26 - 19)
+    const __m256i p4_par = _mm256_set1_epi64x(0xFFFFFFC);  // 4*(2^26 - 1)
+    const __m256i p4_impar = _mm256_set1_epi64x(0x7FFFFFC); // 4*(2^25 - 1)
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+    {
+        const __m256i p4 = (i == 0) ? p4_0 : ((i & 1) ? p4_impar : p4_par);
+        h.v[i] = _mm256_sub_epi64(_mm256_add_epi64(f.v[i], p4), g.v[i]);
+    }
+    fe4_carry(h);
+}
+
+// h = f * g mod p, limbs de entrada < 2^27 (produtos < 2^59.3, somas de 10 termos < 2^63)
+FE_AVX2 inline void fe4_mul(fe25519x4 &h, const fe25519x4 &f, const fe25519x4 &g)
+{
+    INSTR_SOMA(INSTR_MUL_CORPO, 4);
+    const __m256i dezenove = _mm256_set1_epi64x(19);
+    __m256i g19[10], f2[10], r[10];
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+    {
+        g19[i] = _mm256_mul_epu32(g.v[i], dezenove);
+        f2[i] = (i & 1) ? _mm256_slli_epi64(f.v[i], 1) : f.v[i];
+        r[i] = _mm256_setzero_si256();
+    }
+
+    // f_i*g_j cai no limb i + j; dois indices impares ganham fator 2 (2^26*2^26 = 2*2^51)
+    // e i + j >= 10 da a volta com fator 19 (2^255 = 19 mod p)
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+        #pragma GCC unroll 10
+        for (int j = 0; j < 10; ++j)
+        {
+            const __m256i fi = (j & 1) ? f2[i] : f.v[i];
+            const __m256i gj = (i + j >= 10) ? g19[j] : g.v[j];
+            r[(i + j) % 10] = _mm256_add_epi64(r[(i + j) % 10], _mm256_mul_epu32(fi, gj));
+        }
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+        h.v[i] = r[i];
+    fe4_carry(h);
+}
+
+// h = f² mod p: cada par i < j aparece uma vez com fator 2 (55 produtos em vez de 100)
+FE_AVX2 inline void fe4_sq(fe25519x4 &h, const fe25519x4 &f)
+{
+    INSTR_SOMA(INSTR_QUAD_CORPO, 4);
+    const __m256i dezenove = _mm256_set1_epi64x(19);
+    __m256i f19[10], f2[10], f4[10], r[10];
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+    {
+        f19[i] = _mm256_mul_epu32(f.v[i], dezenove);
+        f2[i] = _mm256_slli_epi64(f.v[i], 1);
+        f4[i] = _mm256_slli_epi64(f.v[i], 2);
+        r[i] = _mm256_setzero_si256();
+    }
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+        #pragma GCC unroll 10
+        for (int j = i; j < 10; ++j)
+        {
+            // fator = (i != j ? 2 : 1) * (i e j impares ? 2 : 1)
+            const int fator = (i != j ? 2 : 1) * ((i & j & 1) ? 2 : 1);
+            const __m256i fi = (fator == 4) ? f4[i] : ((fator == 2) ? f2[i] : f.v[i]);
+            const __m256i fj = (i + j >= 10) ? f19[j] : f.v[j];
+            r[(i + j) % 10] = _mm256_add_epi64(r[(i + j) % 10], _mm256_mul_epu32(fi, fj));
+        }
+
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+        h.v[i] = r[i];
+    fe4_carry(h);
+}
+
+// h = f * c mod p, c < 2^32 (ex.: a24 = 121666)
+FE_AVX2 inline void fe4_mul_ui(fe25519x4 &h, const fe25519x4 &f, uint32_t c)
+{
+    const __m256i cc = _mm256_set1_epi64x(c);
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+        h.v[i] = _mm256_mul_epu32(f.v[i], cc);
+    fe4_carry(h);
+}
+
+// Troca f e g nas lanes em que mascara = 0xFF..FF (constant-time)
+FE_AVX2 inline void fe4_cswap(fe25519x4 &f, fe25519x4 &g, __m256i mascara)
+{
+    #pragma GCC unroll 10
+    for (int i = 0; i < 10; ++i)
+    {
+        __m256i x = _mm256_and_si256(_mm256_xor_si256(f.v[i], g.v[i]), mascara);
+        f.v[i] = _mm256_xor_si256(f.v[i], x);
+        g.v[i] = _mm256_xor_si256(g.v[i], x);
+    }
+}
+
+// Empacota 4 elementos radix 2^51: limb 2k = v[k] mod 2^26, limb 2k+1 = v[k] >> 26
+FE_AVX2 inline void fe4_from_fe(fe25519x4 &h, const fe25519 a[4])
+{
+    fe25519 t[4];
+    for (int l = 0; l < 4; ++l)
+    {
+        t[l] = a[l];
+        fe_carry(t[l]);
+    }
+    for (int k = 0; k < 5; ++k)
+    {
+        h.v[2 * k] = _mm256_set_epi64x(t[3].v[k] & ((1 << 26) - 1), t[2].v[k] & ((1 << 26) - 1),
+                                       t[1].v[k] & ((1 << 26) - 1), t[0].v[k] & ((1 << 26) - 1));
+        h.v[2 * k + 1] = _mm256_set_epi64x(t[3].v[k] >> 26, t[2].v[k] >> 26, t[1].v[k] >> 26, t[0].v[k] >> 26);
+    }
+}
+
+// Desempacota para radix 2^51: v[k] = limb 2k + limb 2k+1 * 2^26
+FE_AVX2 inline void fe4_to_fe(fe25519 a[4], const fe25519x4 &h)
+{
+    alignas(32) uint64_t par[4], impar[4];
+    for (int k = 0; k < 5; ++k)
+    {
+        _mm256_store_si256((__m256i *)par, h.v[2 * k]);
+        _mm256_store_si256((__m256i *)impar, h.v[2 * k + 1]);
+        for (int l = 0; l < 4; ++l)
+            a[l].v[k] = par[l] + (impar[l] << 26);
+    }
+    for (int l = 0; l < 4; ++l)
+        fe_carry(a[l]);
+}
+
+#endif // FE25519_AVX2_H
@@ -0,0 +1,712 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Grupo da curva de Edwards torcida -x² + y² = 1 + d*x²*y² (Ed25519), que eh
+birracionalmente equivalente a Curve25519: u = (1 + y)/(1 - y).
+Coordenadas estendidas (X:Y:Z:T) com x = X/Z, y = Y/Z e T = X*Y/Z.
+
+Multiplicacao por base fixa: tabela de 32 x 8 multiplos j*256^i*B montada uma
+unica vez e digitos com sinal em radix 16 (e_i em [-8, 8]), com selecao da
+tabela em tempo constante (mesma estrategia do ref10 de Bernstein et al.).
+____________________________________________________________________________*/
+
+#ifndef GE25519_H
+#define GE25519_H
+
+#include "fe25519.h"
+
+// Ponto projetivo (X:Y:Z)
+struct ge_p2
+{
+    fe25519 X, Y, Z;
+};
+
+// Ponto estendido (X:Y:Z:T), T = X*Y/Z
+struct ge_p3
+{
+    fe25519 X, Y, Z, T;
+};
+
+// Ponto "completo" ((X:Z), (Y:T)) resultado intermediario das somas e duplicacoes
+struct ge_p1p1
+{
+    fe25519 X, Y, Z, T;
+};
+
+// Ponto afim pre-computado (y + x, y - x, 2*d*x*y) usado na tabela da base
+struct ge_precomp
+{
+    fe25519 yplusx, yminusx, xy2d;
+};
+
+// Ponto estendido pre-processado para somas genericas (Y + X, Y - X, Z, 2*d*T)
+struct ge_cached
+{
+    fe25519 YplusX, YminusX, Z, T2d;
+};
+
+// Constantes da curva: d = -121665/121666 e 2d
+struct ConstantesEd25519
+{
+    fe25519 d, d2;
+};
+
+inline const ConstantesEd25519 &constantes_ed25519()
+{
+    static const ConstantesEd25519 c = []() {
+        ConstantesEd25519 r;
+        fe25519 num, den, zero;
+        fe_0(zero);
+        fe_set_ui(num, 121665);
+        fe_sub(num, zero, num);          // -121665
+        fe_set_ui(den, 121666);
+        fe_invert(den, den);
+        fe_mul(r.d, num, den);           // d = -121665/121666
+        fe_add(r.d2, r.d, r.d);
+        fe_carry(r.d2);                  // 2d
+        return r;
+    }();
+    return c;
+}
+
+inline void ge_p3_0(ge_p3 &h)
+{
+    fe_0(h.X);
+    fe_1(h.Y);
+    fe_1(h.Z);
+    fe_0(h.T);
+}
+
+inline void ge_precomp_0(ge_precomp &h)
+{
+    fe_1(h.yplusx);
+    fe_1(h.yminusx);
+    fe_0(h.xy2d);
+}
+
+inline void ge_p1p1_to_p2(ge_p2 &r, const ge_p1p1 &p)
+{
+    fe_mul(r.X, p.X, p.T);
+    fe_mul(r.Y, p.Y, p.Z);
+    fe_mul(r.Z, p.Z, p.T);
+}
+
+inline void ge_p1p1_to_p3(ge_p3 &r, const ge_p1p1 &p)
+{
+    fe_mul(r.X, p.X, p.T);
+    fe_mul(r.Y, p.Y, p.Z);
+    fe_mul(r.Z, p.Z, p.T);
+    fe_mul(r.T, p.X, p.Y);
+}
+
+inline void ge_p3_to_p2(ge_p2 &r, const ge_p3 &p)
+{
+    r.X = p.X;
+    r.Y = p.Y;
+    r.Z = p.Z;
+}
+
+inline void ge_p3_to_cached(ge_cached &r, const ge_p3 &p)
+{
+    fe_add(r.YplusX, p.Y, p.X);
+    fe_sub(r.YminusX, p.Y, p.X);
+    r.Z = p.Z;
+    fe_mul(r.T2d, p.T, constantes_ed25519().d2);
+}
+
+// r = 2p
+inline void ge_p2_dbl(ge_p1p1 &r, const ge_p2 &p)
+{
+    fe25519 t0;
+    fe_sq(r.X, p.X);
+    fe_sq(r.Z, p.Y);
+    fe_sq(r.T, p.Z);
+    fe_add(r.T, r.T, r.T);
+    fe_add(r.Y, p.X, p.Y);
+    fe_sq(t0, r.Y);
+    fe_add(r.Y, r.Z, r.X);
+    fe_sub(r.Z, r.Z, r.X);
+    fe_sub(r.X, t0, r.Y);
+    fe_sub(r.T, r.T, r.Z);
+}
+
+inline void ge_p3_dbl(ge_p1p1 &r, const ge_p3 &p)
+{
+    ge_p2 q;
+    ge_p3_to_p2(q, p);
+    ge_p2_dbl(r, q);
+}
+
+// r = p + q (q generico)
+inline void ge_add(ge_p1p1 &r, const ge_p3 &p, const ge_cached &q)
+{
+    fe25519 t0;
+    fe_add(r.X, p.Y, p.X);
+    fe_sub(r.Y, p.Y, p.X);
+    fe_mul(r.Z, r.X, q.YplusX);
+    fe_mul(r.Y, r.Y, q.YminusX);
+    fe_mul(r.T, q.T2d, p.T);
+    fe_mul(r.X, p.Z, q.Z);
+    fe_add(t0, r.X, r.X);
+    fe_sub(r.X, r.Z, r.Y);
+    fe_add(r.Y, r.Z, r.Y);
+    fe_add(r.Z, t0, r.T);
+    fe_sub(r.T, t0, r.T);
+}
+
+// r = p + q (q afim da tabela, Z = 1)
+inline void ge_madd(ge_p1p1 &r, const ge_p3 &p, const ge_precomp &q)
+{
+    fe25519 t0;
+    fe_add(r.X, p.Y, p.X);
+    fe_sub(r.Y, p.Y, p.X);
+    fe_mul(r.Z, r.X, q.yplusx);
+    fe_mul(r.Y, r.Y, q.yminusx);
+    fe_mul(r.T, q.xy2d, p.T);
+    fe_add(t0, p.Z, p.Z);
+    fe_sub(r.X, r.Z, r.Y);
+    fe_add(r.Y, r.Z, r.Y);
+    fe_add(r.Z, t0, r.T);
+    fe_sub(r.T, t0, r.T);
+}
+
+// r = p - q (q generico)
+inline void ge_sub(ge_p1p1 &r, const ge_p3 &p, const ge_cached &q)
+{
+    fe25519 t0;
+    fe_add(r.X, p.Y, p.X);
+    fe_sub(r.Y, p.Y, p.X);
+    fe_mul(r.Z, r.X, q.YminusX);
+    fe_mul(r.Y, r.Y, q.YplusX);
+    fe_mul(r.T, q.T2d, p.T);
+    fe_mul(r.X, p.Z, q.Z);
+    fe_add(t0, r.X, r.X);
+    fe_sub(r.X, r.Z, r.Y);
+    fe_add(r.Y, r.Z, r.Y);
+    fe_sub(r.Z, t0, r.T);
+    fe_add(r.T, t0, r.T);
+}
+
+// r = p - q (q afim da tabela, Z = 1)
+inline void ge_msub(ge_p1p1 &r, const ge_p3 &p, const ge_precomp &q)
+{
+    fe25519 t0;
+    fe_add(r.X, p.Y, p.X);
+    fe_sub(r.Y, p.Y, p.X);
+    fe_mul(r.Z, r.X, q.yminusx);
+    fe_mul(r.Y, r.Y, q.yplusx);
+    fe_mul(r.T, q.xy2d, p.T);
+    fe_add(t0, p.Z, p.Z);
+    fe_sub(r.X, r.Z, r.Y);
+    fe_add(r.Y, r.Z, r.Y);
+    fe_sub(r.Z, t0, r.T);
+    fe_add(r.T, t0, r.T);
+}
+
+// Converte para a coordenada u de Montgomery: u = (1 + y)/(1 - y) = (Z + Y)/(Z - Y)
+// (identidade -> u = 0, como a escada de Montgomery)
+inline void ge_p3_to_montgomery_u(fe25519 &u, const ge_p3 &p)
+{
+    fe25519 num, den;
+    fe_add(num, p.Z, p.Y);
+    fe_sub(den, p.Z, p.Y);
+    fe_invert(den, den);
+    fe_mul(u, num, den);
+}
+
+// Ponto base B do Ed25519 (y = 4/5, x par), imagem de u = 9 pela equivalencia birracional
+inline void ge_base(ge_p3 &B)
+{
+    static const uint8_t Bx[32] = {
+        0x1a, 0xd5, 0x25, 0x8f, 0x60, 0x2d, 0x56, 0xc9, 0xb2, 0xa7, 0x25, 0x95, 0x60, 0xc7, 0x2c, 0x69,
+        0x5c, 0xdc, 0xd6, 0xfd, 0x31, 0xe2, 0xa4, 0xc0, 0xfe, 0x53, 0x6e, 0xcd, 0xd3, 0x36, 0x69, 0x21};
+    static const uint8_t By[32] = {
+        0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+        0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66};
+    fe_frombytes(B.X, Bx);
+    fe_frombytes(B.Y, By);
+    fe_1(B.Z);
+    fe_mul(B.T, B.X, B.Y);
+}
+
+// Tabela da base: base[i][j] = (j + 1)*256^i*B em forma afim pre-computada
+struct TabelaBase
+{
+    ge_precomp base[32][8];
+};
+
+inline void ge_p3_to_precomp(ge_precomp &r, const ge_p3 &p)
+{
+    fe25519 zinv, x, y;
+    fe_invert(zinv, p.Z);
+    fe_mul(x, p.X, zinv);
+    fe_mul(y, p.Y, zinv);
+    fe_add(r.yplusx, y, x);
+    fe_carry(r.yplusx);
+    fe_sub(r.yminusx, y, x);
+    fe_mul(r.xy2d, x, y);
+    fe_mul(r.xy2d, r.xy2d, constantes_ed25519().d2);
+}
+
+// Montada na primeira chamada (inicializacao de static local eh thread-safe) e depois somente lida
+inline const TabelaBase &tabela_base()
+{
+    static const TabelaBase *tabela = []() {
+        TabelaBase *t = new TabelaBase;
+        ge_p3 Pi, acc;
+        ge_cached Pi_c;
+        ge_p1p1 r;
+
+        ge_base(Pi);
+        for (int i = 0; i < 32; ++i)
+        {
+            // acc = j*Pi, j = 1..8
+            ge_p3_to_cached(Pi_c, Pi);
+            acc = Pi;
+            ge_p3_to_precomp(t->base[i][0], acc);
+            for (int j = 1; j < 8; ++j)
+            {
+                ge_add(r, acc, Pi_c);
+                ge_p1p1_to_p3(acc, r);
+                ge_p3_to_precomp(t->base[i][j], acc);
+            }
+
+            // Pi = 256*Pi
+            for (int k = 0; k < 8; ++k)
+            {
+                ge_p3_dbl(r, Pi);
+                ge_p1p1_to_p3(Pi, r);
+            }
+        }
+        return t;
+    }();
+    return *tabela;
+}
+
+inline void ge_precomp_cmov(ge_precomp &t, const ge_precomp &u, uint64_t bit)
+{
+    fe_cmov(t.yplusx, u.yplusx, bit);
+    fe_cmov(t.yminusx, u.yminusx, bit);
+    fe_cmov(t.xy2d, u.xy2d, bit);
+}
+
+// 1 se b == c (sem desvio)
+inline uint64_t ge_igual(uint8_t b, uint8_t c)
+{
+    uint64_t x = (uint64_t)(b ^ c);
+    return (x - 1) >> 63;
+}
+
+// t = b*256^pos*B, b em [-8, 8], percorrendo todas as 8 entradas (tempo constante)
+inline void ge_seleciona(ge_precomp &t, const TabelaBase &tab, int pos, int8_t b)
+{
+    const uint8_t negativo = (uint8_t)((uint8_t)b >> 7);
+    const uint8_t babs = (uint8_t)(b - (((-negativo) & b) << 1));
+
+    ge_precomp_0(t);
+    for (int j = 0; j < 8; ++j)
+        ge_precomp_cmov(t, tab.base[pos][j], ge_igual(babs, (uint8_t)(j + 1)));
+
+    // -P = (y - x, y + x, -2dxy)
+    ge_precomp menos_t;
+    fe25519 zero;
+    fe_0(zero);
+    menos_t.yplusx = t.yminusx;
+    menos_t.yminusx = t.yplusx;
+    fe_sub(menos_t.xy2d, zero, t.xy2d);
+    ge_precomp_cmov(t, menos_t, negativo);
+}
+
+// h = a*B, a em 32 bytes little-endian com a[31] <= 127 (a < 2^255)
+inline void ge_scalarmult_base(ge_p3 &h, const uint8_t a[32])
+{
+    const TabelaBase &tab = tabela_base();
+    int8_t e[64];
+    int8_t carry = 0;
+    ge_p1p1 r;
+    ge_p2 s;
+    ge_precomp t;
+
+    // Digitos em radix 16 e recodificacao com sinal: e_i em [-8, 8]
+    for (int i = 0; i < 32; ++i)
+    {
+        e[2 * i] = (int8_t)(a[i] & 15);
+        e[2 * i + 1] = (int8_t)((a[i] >> 4) & 15);
+    }
+    for (int i = 0; i < 63; ++i)
+    {
+        e[i] += carry;
+        carry = (int8_t)((e[i] + 8) >> 4);
+        e[i] -= (int8_t)(carry * 16);
+    }
+    e[63] += carry;
+
+    // Posicoes impares: sum e_i*16^i*B (i impar) = 16 * sum e_i*16^(i-1)*B
+    ge_p3_0(h);
+    for (int i = 1; i < 64; i += 2)
+    {
+        ge_seleciona(t, tab, i / 2, e[i]);
+        ge_madd(r, h, t);
+        ge_p1p1_to_p3(h, r);
+    }
+
+    // h = 16*h
+    ge_p3_dbl(r, h);
+    ge_p1p1_to_p2(s, r);
+    ge_p2_dbl(r, s);
+    ge_p1p1_to_p2(s, r);
+    ge_p2_dbl(r, s);
+    ge_p1p1_to_p2(s, r);
+    ge_p2_dbl(r, s);
+    ge_p1p1_to_p3(h, r);
+
+    // Posicoes pares
+    for (int i = 0; i < 64; i += 2)
+    {
+        ge_seleciona(t, tab, i / 2, e[i]);
+        ge_madd(r, h, t);
+        ge_p1p1_to_p3(h, r);
+    }
+}
+
+// ________________________Codificacao e verificacao (Ed25519)________________________
+
+// 32 bytes: y little-endian com o sinal de x no bit 255 (RFC 8032, sec. 5.1.2)
+inline void ge_p3_tobytes(uint8_t s[32], const ge_p3 &h)
+{
+    fe25519 zinv, x, y;
+    fe_invert(zinv, h.Z);
+    fe_mul(x, h.X, zinv);
+    fe_mul(y, h.Y, zinv);
+    fe_tobytes(s, y);
+    s[31] ^= (uint8_t)(fe_isnegative(x) << 7);
+}
+
+// Decodifica (RFC 8032, sec. 5.1.3): x² = (y² - 1)/(d*y² + 1).
+// Retorna false para y >= p, x inexistente ou x = 0 com bit de sinal 1.
+inline bool ge_frombytes(ge_p3 &h, const uint8_t s[32])
+{
+    uint8_t canonico[32];
+    fe25519 y2, u, v, um;
+
+    fe_frombytes(h.Y, s);
+    fe_tobytes(canonico, h.Y);
+    canonico[31] |= s[31] & 0x80;
+    if (memcmp(canonico, s, 32) != 0)
+        return false;
+
+    fe_1(um);
+    fe_sq(y2, h.Y);
+    fe_sub(u, y2, um);
+    fe_mul(v, y2, constantes_ed25519().d);
+    fe_add(v, v, um);
+    if (!fe_sqrt_razao(h.X, u, v)) // uma unica exponenciacao
+        return false;
+
+    const uint64_t sinal = s[31] >> 7;
+    if (fe_iszero(h.X) && sinal)
+        return false;
+    if (fe_isnegative(h.X) != sinal)
+        fe_neg(h.X, h.X);
+
+    fe_1(h.Z);
+    fe_mul(h.T, h.X, h.Y);
+    return true;
+}
+
+inline void ge_p3_neg(ge_p3 &r, const ge_p3 &p)
+{
+    fe_neg(r.X, p.X);
+    r.Y = p.Y;
+    r.Z = p.Z;
+    fe_neg(r.T, p.T);
+}
+
+// 1 se p eh o elemento neutro (X = 0 e Y = Z)
+inline uint64_t ge_p3_eh_neutro(const ge_p3 &p)
+{
+    return fe_iszero(p.X) & fe_iguais(p.Y, p.Z);
+}
+
+// r = 8p (elimina a componente de ordem pequena antes de comparar com o neutro)
+inline void ge_p3_mul8(ge_p3 &r, const ge_p3 &p)
+{
+    ge_p1p1 t;
+    ge_p2 s;
+    ge_p3_dbl(t, p);
+    ge_p1p1_to_p2(s, t);
+    ge_p2_dbl(t, s);
+    ge_p1p1_to_p2(s, t);
+    ge_p2_dbl(t, s);
+    ge_p1p1_to_p3(r, t);
+}
+
+// Digitos impares com sinal em [-15, 15] com pelo menos 4 zeros entre eles (janela deslizante)
+inline void ge_slide(int8_t r[256], const uint8_t a[32])
+{
+    for (int i = 0; i < 256; ++i)
+        r[i] = (int8_t)(1 & (a[i >> 3] >> (i & 7)));
+
+    for (int i = 0; i < 256; ++i)
+    {
+        if (!r[i])
+            continue;
+        for (int b = 1; b <= 6 && i + b < 256; ++b)
+        {
+            if (!r[i + b])
+                continue;
+            if (r[i] + (r[i + b] << b) <= 15)
+            {
+                r[i] = (int8_t)(r[i] + (r[i + b] << b));
+                r[i + b] = 0;
+            }
+            else if (r[i] - (r[i + b] << b) >= -15)
+            {
+                r[i] = (int8_t)(r[i] - (r[i + b] << b));
+                for (int k = i + b; k < 256; ++k)
+                {
+                    if (!r[k])
+                    {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            }
+            else
+                break;
+        }
+    }
+}
+
+// Multiplos impares da base B, 3B, ..., 15B (afins) para a verificacao
+inline const ge_precomp *base_impares()
+{
+    static const ge_precomp *bi = []() {
+        ge_precomp *t = new ge_precomp[8];
+        ge_p3 B, acc, B2;
+        ge_cached B2_c;
+        ge_p1p1 r;
+        ge_base(B);
+        ge_p3_dbl(r, B);
+        ge_p1p1_to_p3(B2, r);
+        ge_p3_to_cached(B2_c, B2);
+        acc = B;
+        ge_p3_to_precomp(t[0], acc);
+        for (int i = 1; i < 8; ++i)
+        {
+            ge_add(r, acc, B2_c);
+            ge_p1p1_to_p3(acc, r);
+            ge_p3_to_precomp(t[i], acc);
+        }
+        return t;
+    }();
+    return bi;
+}
+
+// h = a*A + b*B em tempo variavel (so para dados publicos: verificacao de assinaturas)
+inline void ge_double_scalarmult_vartime(ge_p3 &h, const uint8_t a[32], const ge_p3 &A, const uint8_t b[32])
+{
+    const ge_precomp *Bi = base_impares();
+    int8_t aslide[256], bslide[256];
+    ge_cached Ai[8]; // A, 3A, ..., 15A
+    ge_p1p1 t;
+    ge_p3 u, A2;
+    ge_p2 r;
+
+    ge_slide(aslide, a);
+    ge_slide(bslide, b);
+
+    ge_p3_to_cached(Ai[0], A);
+    ge_p3_dbl(t, A);
+    ge_p1p1_to_p3(A2, t);
+    for (int i = 0; i < 7; ++i)
+    {
+        ge_add(t, A2, Ai[i]);
+        ge_p1p1_to_p3(u, t);
+        ge_p3_to_cached(Ai[i + 1], u);
+    }
+
+    ge_p3_0(h);
+    int i = 255;
+    while (i >= 0 && !aslide[i] && !bslide[i])
+        --i;
+
+    ge_p3_to_p2(r, h);
+    for (; i >= 0; --i)
+    {
+        ge_p2_dbl(t, r);
+
+        if (aslide[i] > 0)
+        {
+            ge_p1p1_to_p3(u, t);
+            ge_add(t, u, Ai[aslide[i] / 2]);
+        }
+        else if (aslide[i] < 0)
+        {
+            ge_p1p1_to_p3(u, t);
+            ge_sub(t, u, Ai[(-aslide[i]) / 2]);
+        }
+
+        if (bslide[i] > 0)
+        {
+            ge_p1p1_to_p3(u, t);
+            ge_madd(t, u, Bi[bslide[i] / 2]);
+        }
+        else if (bslide[i] < 0)
+        {
+            ge_p1p1_to_p3(u, t);
+            ge_msub(t, u, Bi[(-bslide[i]) / 2]);
+        }
+
+        if (i == 0)
+            ge_p1p1_to_p3(h, t);
+        else
+            ge_p1p1_to_p2(r, t);
+    }
+}
+
+// Janela (em bits) do Pippenger que minimiza ~ (256/c + 1)*(qtd + 2^c) somas
+inline int ge_janela_pippenger(size_t qtd)
+{
+    int melhor = 2;
+    double custo_melhor = 1e300;
+    for (int c = 2; c <= 16; ++c)
+    {
+        double custo = (256 / c + 1) * ((double)qtd + (double)((size_t)1 << c));
+        if (custo < custo_melhor)
+        {
+            custo_melhor = custo;
+            melhor = c;
+        }
+    }
+    return melhor;
+}
+
+// Multiplicacao multi-escalar (Pippenger): h = sum escalares[i]*pontos[i], tempo variavel.
+// Escalares recodificados em digitos com sinal de c bits (|d| <= 2^(c-1)); em cada janela
+// os pontos vao para os baldes |d| (somando ou subtraindo) e sum j*balde[j] sai de
+// somas corridas, com ~ qtd + 2^c somas por janela.
+inline void ge_multiescalar_vartime(ge_p3 &h, const uint8_t (*escalares)[32], const ge_p3 *pontos, size_t qtd)
+{
+    const int c = ge_janela_pippenger(qtd);
+    const size_t num_baldes = (size_t)1 << (c - 1);
+    const int num_janelas = 256 / c + 1;
+
+    // Digitos com sinal: d = bits da janela + carry; se d > 2^(c-1), d -= 2^c e carry = 1
+    int32_t *digitos = new int32_t[qtd * num_janelas];
+    for (size_t i = 0; i < qtd; ++i)
+    {
+        int32_t carry = 0;
+        for (int w = 0; w < num_janelas; ++w)
+        {
+            int32_t d = carry;
+            for (int k = 0; k < c; ++k)
+            {
+                int bit = w * c + k;
+                if (bit < 256)
+                    d += ((escalares[i][bit >> 3] >> (bit & 7)) & 1) << k;
+            }
+            carry = d > (int32_t)num_baldes;
+            digitos[i * num_janelas + w] = d - (carry << c);
+        }
+    }
+
+    ge_cached *cached = new ge_cached[qtd];
+    for (size_t i = 0; i < qtd; ++i)
+        ge_p3_to_cached(cached[i], pontos[i]);
+
+    ge_p3 *baldes = new ge_p3[num_baldes];
+    bool *ocupado = new bool[num_baldes];
+    ge_p1p1 t;
+    ge_p3 soma, corrida;
+    ge_cached aux;
+
+    ge_p3_0(h);
+    for (int w = num_janelas - 1; w >= 0; --w)
+    {
+        // h = 2^c * h
+        for (int k = 0; k < c; ++k)
+        {
+            ge_p3_dbl(t, h);
+            ge_p1p1_to_p3(h, t);
+        }
+
+        for (size_t j = 0; j < num_baldes; ++j)
+            ocupado[j] = false;
+
+        for (size_t i = 0; i < qtd; ++i)
+        {
+            int32_t d = digitos[i * num_janelas + w];
+            if (d == 0)
+                continue;
+            size_t j = (size_t)(d > 0 ? d : -d) - 1;
+
+            if (!ocupado[j])
+            {
+                // balde vazio: copia o ponto (ou o oposto) sem somar ao neutro
+                if (d > 0)
+                    baldes[j] = pontos[i];
+                else
+                    ge_p3_neg(baldes[j], pontos[i]);
+                ocupado[j] = true;
+                continue;
+            }
+            if (d > 0)
+                ge_add(t, baldes[j], cached[i]);
+            else
+                ge_sub(t, baldes[j], cached[i]);
+            ge_p1p1_to_p3(baldes[j], t);
+        }
+
+        // sum (j + 1)*balde[j] = sum_j (balde[top] + ... + balde[j])
+        bool tem_corrida = false, tem_soma = false;
+        for (size_t j = num_baldes; j-- > 0;)
+        {
+            if (ocupado[j])
+            {
+                if (tem_corrida)
+                {
+                    ge_p3_to_cached(aux, baldes[j]);
+                    ge_add(t, corrida, aux);
+                    ge_p1p1_to_p3(corrida, t);
+                }
+                else
+                {
+                    corrida = baldes[j];
+                    tem_corrida = true;
+                }
+            }
+            if (tem_corrida)
+            {
+                if (tem_soma)
+                {
+                    ge_p3_to_cached(aux, corrida);
+                    ge_add(t, soma, aux);
+                    ge_p1p1_to_p3(soma, t);
+                }
+                else
+                {
+                    soma = corrida;
+                    tem_soma = true;
+                }
+            }
+        }
+
+        if (tem_soma)
+        {
+            ge_p3_to_cached(aux, soma);
+            ge_add(t, h, aux);
+            ge_p1p1_to_p3(h, t);
+        }
+    }
+
+    delete[] digitos;
+    delete[] cached;
+    delete[] baldes;
+    delete[] ocupado;
+}
+
+#endif // GE25519_H
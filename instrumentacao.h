@@ -0,0 +1,287 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+Instrumentacao do caminho critico: contadores (multiplicacoes, quadrados e
+inversoes no corpo, exponenciacoes modulares, passos da escada, tentativas da
+codificacao, bytes entregues pelo CSPRNG e bytes lidos da fonte de entropia)
+e histogramas de tempo por estagio.
+
+So existe quando compilado com -DECC_INSTRUMENTACAO. Sem a flag as macros
+INSTR_* nao geram codigo e instr_snapshot() devolve tudo zerado.
+
+Cada thread incrementa os seus proprios contadores (sem instrucoes atomicas
+com lock); instr_snapshot() soma as threads vivas e as que ja terminaram.
+____________________________________________________________________________*/
+
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+enum InstrContador
+{
+    INSTR_MUL_CORPO,       // fe_mul (e 4 por fe4_mul)
+    INSTR_QUAD_CORPO,      // fe_sq (e 4 por fe4_sq)
+    INSTR_INV_CORPO,       // fe_invert
+    INSTR_EXP_MODULAR,     // fe_pow22523 e mpz_powm
+    INSTR_PASSOS_LADDER,   // double_add_ponto
+    INSTR_TENTATIVAS_COD,  // valores de x testados na codificacao de mensagens
+    INSTR_BYTES_RNG,       // bytes entregues por csprng_bytes (chaves, escalares)
+    INSTR_BYTES_ENTROPIA,  // bytes lidos do getrandom (sementes do CSPRNG)
+    INSTR_NUM_CONTADORES
+};
+
+enum InstrEstagio
+{
+    INSTR_EST_LADDER,      // ladder_projetivo
+    INSTR_EST_INVERSAO,    // conv_coord_proj_to_afim
+    INSTR_EST_BASE_FIXA,   // multiplicacao_escalar_base
+    INSTR_EST_CODIFICACAO, // codifica_mensagem_* (laco de tentativas)
+    INSTR_EST_RNG,         // gera_escalar_rand
+    INSTR_EST_KDF,         // deriva_chave_simetrica
+    INSTR_EST_ENCRIPTA,    // encriptar_mensagem
+    INSTR_EST_DECRIPTA,    // decriptar_mensagem
+    INSTR_NUM_ESTAGIOS
+};
+
+static const char *const INSTR_NOMES_CONTADORES[INSTR_NUM_CONTADORES] = {
+    "mul_corpo", "quad_corpo", "inv_corpo", "exp_modular", "passos_ladder", "tentativas_cod", "bytes_rng",
+    "bytes_entropia"};
+
+static const char *const INSTR_NOMES_ESTAGIOS[INSTR_NUM_ESTAGIOS] = {
+    "ladder", "inversao", "base_fixa", "codificacao", "rng", "kdf", "encripta", "decripta"};
+
+// Histograma log2: faixa i conta as duracoes em [2^i, 2^(i+1)) ns (faixa 0 inclui 0 ns)
+static const int INSTR_FAIXAS = 40;
+
+struct InstrHistograma
+{
+    uint64_t chamadas, total_ns, max_ns;
+    uint64_t faixas[INSTR_FAIXAS];
+};
+
+struct InstrSnapshot
+{
+    uint64_t contadores[INSTR_NUM_CONTADORES];
+    InstrHistograma estagios[INSTR_NUM_ESTAGIOS];
+};
+
+// Limite superior do percentil q (0..1) a partir das faixas (nunca acima do maximo observado)
+inline uint64_t instr_percentil_ns(const InstrHistograma &h, double q)
+{
+    if (h.chamadas == 0)
+        return 0;
+    uint64_t alvo = (uint64_t)(q * (double)h.chamadas + 0.999999), acumulado = 0;
+    if (alvo == 0)
+        alvo = 1;
+    for (int i = 0; i < INSTR_FAIXAS; ++i)
+    {
+        acumulado += h.faixas[i];
+        if (acumulado >= alvo)
+        {
+            uint64_t limite = (1ULL << (i + 1)) - 1;
+            return limite < h.max_ns ? limite : h.max_ns;
+        }
+    }
+    return h.max_ns;
+}
+
+#ifdef ECC_INSTRUMENTACAO
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+static const bool INSTR_ATIVA = true;
+
+// Escrito apenas pela thread dona (load + store relaxados: um add comum no x86);
+// lido por instr_snapshot() em qualquer thread
+struct InstrHistogramaThread
+{
+    std::atomic<uint64_t> chamadas{0}, total_ns{0}, max_ns{0};
+    std::atomic<uint64_t> faixas[INSTR_FAIXAS] = {};
+};
+
+struct InstrThread;
+
+struct InstrRegistro
+{
+    std::mutex trava;
+    std::vector<InstrThread *> vivas;
+    InstrSnapshot encerradas = {}; // soma das threads que ja terminaram
+};
+
+inline InstrRegistro &instr_registro()
+{
+    static InstrRegistro *r = new InstrRegistro; // nunca destruido: threads podem terminar depois do main
+    return *r;
+}
+
+inline void instr_acumula(InstrSnapshot &s, const InstrThread &t);
+
+struct InstrThread
+{
+    std::atomic<uint64_t> contadores[INSTR_NUM_CONTADORES] = {};
+    InstrHistogramaThread estagios[INSTR_NUM_ESTAGIOS];
+
+    InstrThread()
+    {
+        InstrRegistro &r = instr_registro();
+        std::lock_guard<std::mutex> trava(r.trava);
+        r.vivas.push_back(this);
+    }
+
+    ~InstrThread()
+    {
+        InstrRegistro &r = instr_registro();
+        std::lock_guard<std::mutex> trava(r.trava);
+        instr_acumula(r.encerradas, *this);
+        r.vivas.erase(std::find(r.vivas.begin(), r.vivas.end(), this));
+    }
+};
+
+inline void instr_acumula(InstrSnapshot &s, const InstrThread &t)
+{
+    for (int i = 0; i < INSTR_NUM_CONTADORES; ++i)
+        s.contadores[i] += t.contadores[i].load(std::memory_order_relaxed);
+    for (int e = 0; e < INSTR_NUM_ESTAGIOS; ++e)
+    {
+        const InstrHistogramaThread &ht = t.estagios[e];
+        InstrHistograma &h = s.estagios[e];
+        h.chamadas += ht.chamadas.load(std::memory_order_relaxed);
+        h.total_ns += ht.total_ns.load(std::memory_order_relaxed);
+        h.max_ns = std::max(h.max_ns, ht.max_ns.load(std::memory_order_relaxed));
+        for (int i = 0; i < INSTR_FAIXAS; ++i)
+            h.faixas[i] += ht.faixas[i].load(std::memory_order_relaxed);
+    }
+}
+
+inline InstrThread &instr_thread()
+{
+    static thread_local InstrThread t;
+    return t;
+}
+
+inline void instr_soma(std::atomic<uint64_t> &c, uint64_t n)
+{
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void instr_conta(InstrContador c, uint64_t n)
+{
+    instr_soma(instr_thread().contadores[c], n);
+}
+
+inline uint64_t instr_agora_ns()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void instr_registra(InstrEstagio e, uint64_t ns)
+{
+    InstrHistogramaThread &h = instr_thread().estagios[e];
+    int faixa = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+    if (faixa >= INSTR_FAIXAS)
+        faixa = INSTR_FAIXAS - 1;
+    instr_soma(h.chamadas, 1);
+    instr_soma(h.total_ns, ns);
+    instr_soma(h.faixas[faixa], 1);
+    if (ns > h.max_ns.load(std::memory_order_relaxed))
+        h.max_ns.store(ns, std::memory_order_relaxed);
+}
+
+// Mede do construtor ao fim do escopo
+struct InstrCronometro
+{
+    InstrEstagio estagio;
+    uint64_t inicio;
+    explicit InstrCronometro(InstrEstagio e) : estagio(e), inicio(instr_agora_ns()) {}
+    ~InstrCronometro() { instr_registra(estagio, instr_agora_ns() - inicio); }
+};
+
+inline InstrSnapshot instr_snapshot()
+{
+    InstrRegistro &r = instr_registro();
+    std::lock_guard<std::mutex> trava(r.trava);
+    InstrSnapshot s = r.encerradas;
+    for (const InstrThread *t : r.vivas)
+        instr_acumula(s, *t);
+    return s;
+}
+
+// Zera os contadores de todas as threads (chamar com as threads paradas para um inicio exato)
+inline void instr_zera()
+{
+    InstrRegistro &r = instr_registro();
+    std::lock_guard<std::mutex> trava(r.trava);
+    r.encerradas = InstrSnapshot();
+    for (InstrThread *t : r.vivas)
+    {
+        for (int i = 0; i < INSTR_NUM_CONTADORES; ++i)
+            t->contadores[i].store(0, std::memory_order_relaxed);
+        for (int e = 0; e < INSTR_NUM_ESTAGIOS; ++e)
+        {
+            InstrHistogramaThread &h = t->estagios[e];
+            h.chamadas.store(0, std::memory_order_relaxed);
+            h.total_ns.store(0, std::memory_order_relaxed);
+            h.max_ns.store(0, std::memory_order_relaxed);
+            for (int i = 0; i < INSTR_FAIXAS; ++i)
+                h.faixas[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+#define INSTR_CONCATENA_(a, b) a##b
+#define INSTR_CONCATENA(a, b) INSTR_CONCATENA_(a, b)
+#define INSTR_CONTA(c) instr_conta((c), 1)
+#define INSTR_SOMA(c, n) instr_conta((c), (uint64_t)(n))
+#define INSTR_ESTAGIO(e) InstrCronometro INSTR_CONCATENA(instr_cronometro_, __LINE__)(e)
+
+#else // sem ECC_INSTRUMENTACAO: custo zero
+
+static const bool INSTR_ATIVA = false;
+
+inline InstrSnapshot instr_snapshot()
+{
+    return InstrSnapshot();
+}
+
+inline void instr_zera() {}
+
+#define INSTR_CONTA(c) ((void)0)
+#define INSTR_SOMA(c, n) ((void)0)
+#define INSTR_ESTAGIO(e) ((void)0)
+
+#endif // ECC_INSTRUMENTACAO
+
+// Relatorio legivel de um snapshot (contadores e, por estagio, chamadas, media e percentis)
+inline void instr_imprime(FILE *f, const InstrSnapshot &s)
+{
+    if (!INSTR_ATIVA)
+    {
+        fprintf(f, "Instrumentacao desativada (compile com -DECC_INSTRUMENTACAO)\n");
+        return;
+    }
+    fprintf(f, "%-16s %14s\n", "contador", "total");
+    for (int i = 0; i < INSTR_NUM_CONTADORES; ++i)
+        fprintf(f, "%-16s %14llu\n", INSTR_NOMES_CONTADORES[i], (unsigned long long)s.contadores[i]);
+
+    fprintf(f, "\n%-16s %10s %12s %12s %12s %12s\n", "estagio", "chamadas", "media ns", "p50 ns <=", "p99 ns <=", "max ns");
+    for (int e = 0; e < INSTR_NUM_ESTAGIOS; ++e)
+    {
+        const InstrHistograma &h = s.estagios[e];
+        if (h.chamadas == 0)
+            continue;
+        fprintf(f, "%-16s %10llu %12llu %12llu %12llu %12llu\n", INSTR_NOMES_ESTAGIOS[e], (unsigned long long)h.chamadas,
+                (unsigned long long)(h.total_ns / h.chamadas), (unsigned long long)instr_percentil_ns(h, 0.50),
+                (unsigned long long)instr_percentil_ns(h, 0.99), (unsigned long long)h.max_ns);
+    }
+}
+
+#endif // INSTRUMENTACAO_H
@@ -0,0 +1,287 @@
+/*____________________________________________________________________________
+Code developed by Iago Lucas (iagolbg@gmail.com | GitHub: iagolucas88)
+for his master's degree in Mechatronic Engineering at the
+Federal University of Rio Grande do Norte (Brazil).
+
+SHA-512 (FIPS 180-4) com interface incremental inicia/atualiza/finaliza,
+HMAC-SHA-512 (RFC 2104) e HKDF-SHA-512 (RFC 5869) sobre buffers de bytes.
+Usado pela derivacao de chaves do ECDH e pelas assinaturas Ed25519.
+____________________________________________________________________________*/
+
+#ifndef SHA512_H
+#define SHA512_H
+
+#include <stdint.h>
+#include <string.h>
+
+static const size_t SHA512_TAM_BLOCO = 128;
+static const size_t SHA512_TAM_HASH = 64;
+
+struct Sha512
+{
+    uint64_t h[8];
+    uint8_t bloco[128]; // bytes ainda nao comprimidos
+    size_t usados;      // bytes validos em 'bloco'
+    uint64_t total;     // bytes processados (mensagens ate 2^64 - 1 bytes)
+};
+
+static const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+inline uint64_t sha512_rotr(uint64_t x, int n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+inline uint64_t sha512_be64(const uint8_t *b)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+        v = (v << 8) | b[i];
+    return v;
+}
+
+inline void sha512_grava_be64(uint8_t *b, uint64_t v)
+{
+    for (int i = 7; i >= 0; --i)
+    {
+        b[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+#define SHA512_RODADA(a, b, c, d, e, f, g, h, k, w)                                          \
+    {                                                                                        \
+        uint64_t t1 = h + (sha512_rotr(e, 14) ^ sha512_rotr(e, 18) ^ sha512_rotr(e, 41)) +   \
+                      ((e & f) ^ (~e & g)) + k + w;                                          \
+        uint64_t t2 = (sha512_rotr(a, 28) ^ sha512_rotr(a, 34) ^ sha512_rotr(a, 39)) +       \
+                      ((a & b) ^ (a & c) ^ (b & c));                                         \
+        d += t1;                                                                             \
+        h = t1 + t2;                                                                         \
+    }
+
+// Comprime 'qtd' blocos de 128 bytes. A agenda usa uma janela circular de 16
+// palavras (W[t] so depende de W[t-2], W[t-7], W[t-15] e W[t-16]) e as rodadas
+// vao de 8 em 8 trocando o papel das variaveis em vez de move-las.
+inline void sha512_comprime(uint64_t h[8], const uint8_t *dados, size_t qtd)
+{
+    for (; qtd > 0; --qtd, dados += SHA512_TAM_BLOCO)
+    {
+        uint64_t w[16];
+        uint64_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+
+        for (int t = 0; t < 16; ++t)
+            w[t] = sha512_be64(dados + 8 * t);
+
+        for (int t = 0; t < 80; t += 16)
+        {
+            if (t > 0)
+            {
+                #pragma GCC unroll 16
+                for (int i = 0; i < 16; ++i)
+                {
+                    uint64_t w15 = w[(i + 1) & 15], w2 = w[(i + 14) & 15];
+                    w[i] += (sha512_rotr(w15, 1) ^ sha512_rotr(w15, 8) ^ (w15 >> 7)) + w[(i + 9) & 15] +
+                            (sha512_rotr(w2, 19) ^ sha512_rotr(w2, 61) ^ (w2 >> 6));
+                }
+            }
+            #pragma GCC unroll 2
+            for (int i = 0; i < 16; i += 8)
+            {
+                SHA512_RODADA(a, b, c, d, e, f, g, hh, SHA512_K[t + i], w[i]);
+                SHA512_RODADA(hh, a, b, c, d, e, f, g, SHA512_K[t + i + 1], w[i + 1]);
+                SHA512_RODADA(g, hh, a, b, c, d, e, f, SHA512_K[t + i + 2], w[i + 2]);
+                SHA512_RODADA(f, g, hh, a, b, c, d, e, SHA512_K[t + i + 3], w[i + 3]);
+                SHA512_RODADA(e, f, g, hh, a, b, c, d, SHA512_K[t + i + 4], w[i + 4]);
+                SHA512_RODADA(d, e, f, g, hh, a, b, c, SHA512_K[t + i + 5], w[i + 5]);
+                SHA512_RODADA(c, d, e, f, g, hh, a, b, SHA512_K[t + i + 6], w[i + 6]);
+                SHA512_RODADA(b, c, d, e, f, g, hh, a, SHA512_K[t + i + 7], w[i + 7]);
+            }
+        }
+
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+    }
+}
+
+inline void sha512_inicia(Sha512 &s)
+{
+    static const uint64_t H0[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+    memcpy(s.h, H0, sizeof(H0));
+    s.usados = 0;
+    s.total = 0;
+}
+
+inline void sha512_atualiza(Sha512 &s, const uint8_t *dados, size_t tam)
+{
+    s.total += tam;
+
+    // Completa o bloco pendente
+    if (s.usados > 0)
+    {
+        size_t falta = SHA512_TAM_BLOCO - s.usados;
+        size_t n = tam < falta ? tam : falta;
+        memcpy(s.bloco + s.usados, dados, n);
+        s.usados += n;
+        dados += n;
+        tam -= n;
+        if (s.usados < SHA512_TAM_BLOCO)
+            return;
+        sha512_comprime(s.h, s.bloco, 1);
+        s.usados = 0;
+    }
+
+    // Blocos inteiros direto da entrada, sem copia
+    size_t inteiros = tam / SHA512_TAM_BLOCO;
+    sha512_comprime(s.h, dados, inteiros);
+    dados += inteiros * SHA512_TAM_BLOCO;
+    tam -= inteiros * SHA512_TAM_BLOCO;
+
+    memcpy(s.bloco, dados, tam);
+    s.usados = tam;
+}
+
+// Padding: 0x80, zeros e o tamanho em bits (128 bits big-endian)
+inline void sha512_finaliza(Sha512 &s, uint8_t hash[64])
+{
+    uint64_t bits = s.total << 3;
+    uint64_t bits_alto = s.total >> 61;
+
+    s.bloco[s.usados++] = 0x80;
+    if (s.usados > SHA512_TAM_BLOCO - 16)
+    {
+        memset(s.bloco + s.usados, 0, SHA512_TAM_BLOCO - s.usados);
+        sha512_comprime(s.h, s.bloco, 1);
+        s.usados = 0;
+    }
+    memset(s.bloco + s.usados, 0, SHA512_TAM_BLOCO - 16 - s.usados);
+    sha512_grava_be64(s.bloco + 112, bits_alto);
+    sha512_grava_be64(s.bloco + 120, bits);
+    sha512_comprime(s.h, s.bloco, 1);
+
+    for (int i = 0; i < 8; ++i)
+        sha512_grava_be64(hash + 8 * i, s.h[i]);
+
+    volatile uint8_t *v = (volatile uint8_t *)&s; // apaga o estado
+    for (size_t i = 0; i < sizeof(s); ++i)
+        v[i] = 0;
+}
+
+inline void sha512(uint8_t hash[64], const uint8_t *dados, size_t tam)
+{
+    Sha512 s;
+    sha512_inicia(s);
+    sha512_atualiza(s, dados, tam);
+    sha512_finaliza(s, hash);
+}
+
+// ________________________HMAC-SHA-512 (RFC 2104)________________________
+
+struct HmacSha512
+{
+    Sha512 interno, externo; // ja alimentados com K ^ ipad e K ^ opad
+};
+
+inline void hmac_sha512_inicia(HmacSha512 &m, const uint8_t *chave, size_t tam_chave)
+{
+    uint8_t k[SHA512_TAM_BLOCO] = {0}, pad[SHA512_TAM_BLOCO];
+
+    // Chaves maiores que o bloco sao substituidas pelo seu hash
+    if (tam_chave > SHA512_TAM_BLOCO)
+        sha512(k, chave, tam_chave);
+    else
+        memcpy(k, chave, tam_chave);
+
+    for (size_t i = 0; i < SHA512_TAM_BLOCO; ++i)
+        pad[i] = k[i] ^ 0x36;
+    sha512_inicia(m.interno);
+    sha512_atualiza(m.interno, pad, SHA512_TAM_BLOCO);
+
+    for (size_t i = 0; i < SHA512_TAM_BLOCO; ++i)
+        pad[i] = k[i] ^ 0x5c;
+    sha512_inicia(m.externo);
+    sha512_atualiza(m.externo, pad, SHA512_TAM_BLOCO);
+
+    memset(k, 0, sizeof(k));
+    memset(pad, 0, sizeof(pad));
+}
+
+inline void hmac_sha512_atualiza(HmacSha512 &m, const uint8_t *dados, size_t tam)
+{
+    sha512_atualiza(m.interno, dados, tam);
+}
+
+inline void hmac_sha512_finaliza(HmacSha512 &m, uint8_t mac[64])
+{
+    uint8_t interno[SHA512_TAM_HASH];
+    sha512_finaliza(m.interno, interno);
+    sha512_atualiza(m.externo, interno, SHA512_TAM_HASH);
+    sha512_finaliza(m.externo, mac);
+    memset(interno, 0, sizeof(interno));
+}
+
+inline void hmac_sha512(uint8_t mac[64], const uint8_t *chave, size_t tam_chave, const uint8_t *dados, size_t tam)
+{
+    HmacSha512 m;
+    hmac_sha512_inicia(m, chave, tam_chave);
+    hmac_sha512_atualiza(m, dados, tam);
+    hmac_sha512_finaliza(m, mac);
+}
+
+// ________________________HKDF-SHA-512 (RFC 5869)________________________
+
+// PRK = HMAC(salt, IKM); salt vazio equivale a 64 bytes zero
+inline void hkdf_extract(uint8_t prk[64], const uint8_t *salt, size_t tam_salt, const uint8_t *ikm, size_t tam_ikm)
+{
+    hmac_sha512(prk, salt, tam_salt, ikm, tam_ikm);
+}
+
+// OKM = T(1) | T(2) | ... truncado em 'tam' bytes, T(i) = HMAC(PRK, T(i-1) | info | i)
+// Retorna false se tam > 255*64 (limite da RFC)
+inline bool hkdf_expand(uint8_t *okm, size_t tam, const uint8_t prk[64], const uint8_t *info, size_t tam_info)
+{
+    if (tam > 255 * SHA512_TAM_HASH)
+        return false;
+
+    uint8_t t[SHA512_TAM_HASH];
+    for (uint8_t i = 1; tam > 0; ++i)
+    {
+        HmacSha512 m;
+        hmac_sha512_inicia(m, prk, SHA512_TAM_HASH);
+        if (i > 1)
+            hmac_sha512_atualiza(m, t, SHA512_TAM_HASH);
+        hmac_sha512_atualiza(m, info, tam_info);
+        hmac_sha512_atualiza(m, &i, 1);
+        hmac_sha512_finaliza(m, t);
+
+        size_t n = tam < SHA512_TAM_HASH ? tam : SHA512_TAM_HASH;
+        memcpy(okm, t, n);
+        okm += n;
+        tam -= n;
+    }
+    memset(t, 0, sizeof(t));
+    return true;
+}
+
+#endif // SHA512_H